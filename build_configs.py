@@ -1,4 +1,4 @@
-plugins_enabled = ["-DDISABLE_PLUGINS_BY_DEFAULT=YES", "-DPLUGIN_DOMINANCE_PRUNING_ENABLED=YES", "-DPLUGIN_PLUGIN_LAZY_GREEDY_ENABLED=TRUE", "-DPLUGIN_BLIND_SEARCH_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_PLUGIN_ASTAR_ENABLED=TRUE", "-DPLUGIN_RELAXATION_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_MAX_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_ADDITIVE_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_FF_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_MAS_HEURISTIC_ENABLED=TRUE","-DPLUGIN_SYMBOLIC_SEARCH_ENGINE_ENABLED=TRUE"]
+plugins_enabled = ["-DDISABLE_PLUGINS_BY_DEFAULT=YES", "-DPLUGIN_DOMINANCE_PRUNING_ENABLED=YES", "-DPLUGIN_PLUGIN_LAZY_GREEDY_ENABLED=TRUE", "-DPLUGIN_BLIND_SEARCH_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_PLUGIN_ASTAR_ENABLED=TRUE", "-DPLUGIN_HDA_STAR_SEARCH_ENABLED=TRUE", "-DPLUGIN_RELAXATION_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_MAX_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_ADDITIVE_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_FF_HEURISTIC_ENABLED=TRUE", "-DPLUGIN_MAS_HEURISTIC_ENABLED=TRUE","-DPLUGIN_SYMBOLIC_SEARCH_ENGINE_ENABLED=TRUE"]
 
 release32 = ["-DCMAKE_BUILD_TYPE=Release"] + plugins_enabled
 debug32 = ["-DCMAKE_BUILD_TYPE=Debug", "-DFORCE_DYNAMIC_BUILD=YES"] + plugins_enabled
@@ -185,9 +185,10 @@ def _check_mutex_args(parser, args, required=False):
 
 
 def _looks_like_search_input(filename):
-    with open(filename) as input_file:
-        first_line = next(input_file, "").rstrip()
-    return first_line == "begin_version"
+    # Text SAS files start with "begin_version", binary ones with "SASBIN".
+    with open(filename, "rb") as input_file:
+        start = input_file.read(len(b"begin_version"))
+    return start == b"begin_version" or start.startswith(b"SASBIN\0")
 
 
 def _set_components_automatically(parser, args):
@@ -387,6 +388,11 @@ def parse_args():
     driver_other.add_argument(
         "--transform-task-options",
         help='comma-separated list of key-value option pairs for task transformation (e.g. h2_time_limit,10)')
+    driver_other.add_argument(
+        "--transform-cache", metavar="DIR",
+        help="store the task transformed by the search component (--transform) "
+            "in DIR and reuse it in later runs and portfolio configurations "
+            "with the same task and transformation")
     driver_other.add_argument(
         "--validate", action="store_true",
         help='validate plans (implied by --debug); needs "validate" (VAL) on PATH')
@@ -205,17 +205,24 @@ def get_portfolio_attributes(portfolio):
     return attributes
 
 
-def run(portfolio, executable, sas_file, plan_manager, time, memory):
+def run(portfolio, executable, sas_file, plan_manager, time, memory,
+        extra_args=None):
     """
     Run the configs in the given portfolio file.
 
     The portfolio is allowed to run for at most *time* seconds and may
-    use a maximum of *memory* bytes.
+    use a maximum of *memory* bytes. *extra_args* are appended to the
+    arguments of every config.
     """
     attributes = get_portfolio_attributes(portfolio)
     configs = attributes["CONFIGS"]
     optimal = attributes["OPTIMAL"]
     final_config = attributes.get("FINAL_CONFIG")
+    if extra_args:
+        configs = [(relative_time, list(args) + extra_args)
+                   for relative_time, args in configs]
+        if final_config:
+            final_config = list(final_config) + extra_args
     final_config_builder = attributes.get("FINAL_CONFIG_BUILDER")
     if "TIMEOUT" in attributes:
         returncodes.exit_with_driver_input_error(
@@ -144,17 +144,24 @@ def run_search(args):
         single_plan=args.portfolio_single_plan)
     plan_manager.delete_existing_plans()
 
+    cache_args = []
+    if args.transform_cache:
+        if not os.path.isdir(args.transform_cache):
+            os.makedirs(args.transform_cache)
+        cache_args = ["--transform-cache", args.transform_cache]
+
     if args.portfolio:
         assert not args.search_options
         logging.info("search portfolio: %s" % args.portfolio)
         return portfolio_runner.run(
             args.portfolio, executable, args.search_input, plan_manager,
-            time_limit, memory_limit)
+            time_limit, memory_limit, extra_args=cache_args)
     else:
         if not args.search_options:
             returncodes.exit_with_driver_input_error(
                 "search needs --alias, --portfolio, or search options")
         if "--help" not in args.search_options:
+            args.search_options.extend(cache_args)
             args.search_options.extend(["--internal-plan-file", args.plan_file])
         try:
             call.check_call(
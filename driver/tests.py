@@ -7,6 +7,7 @@ Test module for Fast Downward driver script. Run with
 """
 
 import os
+import re
 import subprocess
 
 import pytest
@@ -55,6 +56,36 @@ def test_portfolios():
         run_driver(cmd)
 
 
+# Lines of the search output that describe the task and the search result.
+SEARCH_SUMMARY_PATTERN = re.compile(
+    r"^(Variables|FactPairs|Main task|Expanded|Evaluated|Generated|"
+    r"Plan length|Plan cost)")
+
+
+def test_binary_sas_round_trip():
+    """Searching on the binary task written by preprocess-h2 must give the
+    same task and the same search result as searching on the text task."""
+    summaries = []
+    plans = []
+    for output_format in ["text", "binary"]:
+        cleanup()
+        cmd = ["./fast-downward.py",
+               "--transform-task", "preprocess-h2",
+               "--transform-task-options", "output_format," + output_format,
+               "misc/tests/benchmarks/gripper/prob01.pddl",
+               "--search", "astar(blind())"]
+        output = subprocess.check_output(
+            cmd, cwd=REPO_ROOT_DIR, universal_newlines=True)
+        assert ("reading binary input" in output) == (output_format == "binary")
+        summaries.append([line for line in output.splitlines()
+                          if SEARCH_SUMMARY_PATTERN.match(line)])
+        with open(os.path.join(REPO_ROOT_DIR, "sas_plan")) as plan_file:
+            plans.append(plan_file.read())
+    assert summaries[0]
+    assert summaries[0] == summaries[1]
+    assert plans[0] == plans[1]
+
+
 def test_hard_time_limit():
     def preexec_fn():
         limits.set_time_limit(10)
@@ -28,6 +28,7 @@ public:
     void dump() const;
     int get_encoding_size() const;
     void generate_cpp_input(ofstream &outfile) const;
+    void generate_binary_cpp_input(ofstream &outfile) const;
     const vector<Condition> &get_conditions() const {return conditions; }
     Variable *get_effect_var() const {return effect_var; }
     int get_old_val() const {return old_val; }
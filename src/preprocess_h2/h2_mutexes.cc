@@ -5,7 +5,11 @@
 //#include "utilities.h"
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <iterator>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <set>
 
@@ -45,8 +49,12 @@ bool compute_h2_mutexes(const vector <Variable *> &variables,
                         vector<MutexGroup> &mutexes,
                         State &initial_state,
                         const vector<pair<Variable *, int>> &goals,
-                        int limit_seconds, bool disable_bw_h2) {
-    H2Mutexes h2(limit_seconds);
+                        int limit_seconds, bool disable_bw_h2,
+                        int num_threads) {
+    // With several threads, the forward and backward computations of each
+    // iteration run concurrently and share the threads
+    bool parallel_directions = num_threads > 1 && !disable_bw_h2;
+    H2Mutexes h2(limit_seconds, num_threads);
 
     if (!h2.initialize(variables, mutexes)) {
         return true;
@@ -61,8 +69,81 @@ bool compute_h2_mutexes(const vector <Variable *> &variables,
     bool update_regression = true;
     bool regression = false;
     clock_t start_t = clock();
+    auto start_wall = chrono::steady_clock::now();
     int num_iterations = 0;
-    do {
+    while (parallel_directions && (update_progression || update_regression)) {
+        num_iterations++;
+        bool forward = update_progression;
+        // The backward operators rely on the potential preconditions found
+        // by the disambiguation, so the first iteration is only forward
+        bool backward = update_regression && num_iterations > 1;
+        update_progression = false;
+        if (backward)
+            update_regression = false;
+
+        cout << "iteration for mutex detection and operator pruning"
+             << (forward ? " fw" : "") << (backward ? " bw" : "") << endl;
+        // The backward computation works on a copy, which is merged back
+        // after the mutexes found forward have been extracted
+        H2Mutexes h2_bw(backward ? h2 : H2Mutexes());
+        // A direction that runs alone gets all threads
+        if (forward && backward) {
+            h2.set_num_threads(num_threads - num_threads / 2);
+            h2_bw.set_num_threads(num_threads / 2);
+        } else {
+            h2.set_num_threads(num_threads);
+            h2_bw.set_num_threads(num_threads);
+        }
+        ostringstream log_bw;
+        int result_bw = 0;
+        thread thread_bw;
+        if (backward) {
+            thread_bw = thread([&]() {
+                                   result_bw = h2_bw.compute_reachability(
+                                       variables, operators, axioms, initial_state, goals, true, log_bw);
+                               });
+        }
+        int result_fw = 0;
+        if (forward) {
+            result_fw = h2.compute_reachability(
+                variables, operators, axioms, initial_state, goals, false, cout);
+        }
+        if (backward)
+            thread_bw.join();
+        cout << log_bw.str();
+        if (result_fw == UNSOLVABLE || result_bw == UNSOLVABLE) {
+            return false;
+        } else if (result_fw == TIMEOUT || result_bw == TIMEOUT) {
+            break;
+        }
+
+        int mutexes_fw = 0;
+        if (forward) {
+            mutexes_fw = h2.extract_mutexes(variables, operators, initial_state, goals, mutexes, false);
+            if (mutexes_fw == UNSOLVABLE)
+                return false;
+            total_mutexes_fw += mutexes_fw;
+        }
+        int mutexes_bw = 0;
+        if (backward) {
+            h2.adopt_reachability(h2_bw);
+            mutexes_bw = h2.extract_mutexes(variables, operators, initial_state, goals, mutexes, true);
+            if (mutexes_bw == UNSOLVABLE)
+                return false;
+            total_mutexes_bw += mutexes_bw;
+        }
+
+        int res_unreachable = h2.detect_unreachable_fluents(variables, initial_state, goals);
+        if (res_unreachable == UNSOLVABLE)
+            return false;
+        bool unreachable_detected = res_unreachable != 0;
+
+        bool spurious_detected = h2.remove_spurious_operators(operators);
+
+        update_progression |= spurious_detected || unreachable_detected || mutexes_bw;
+        update_regression |= spurious_detected || unreachable_detected || mutexes_fw;
+    }
+    while (!parallel_directions && (update_progression || update_regression)) {
         num_iterations++;
         if ((!regression && update_progression) ||
             (regression && update_regression)) {
@@ -99,9 +180,12 @@ bool compute_h2_mutexes(const vector <Variable *> &variables,
             update_regression |= spurious_detected || unreachable_detected || (!regression && mutexes_detected);
         }
         regression = !regression;
-    } while (update_progression || update_regression);
+    }
 
     cout << "Total mutex and disambiguation time: " << (double)(clock() - start_t) / CLOCKS_PER_SEC << " iterations: " << num_iterations << endl;
+    if (num_threads > 1)
+        cout << "Wall-clock mutex and disambiguation time: "
+             << chrono::duration<double>(chrono::steady_clock::now() - start_wall).count() << endl;
     cout << "Total mutexes found forward: " << total_mutexes_fw << endl;
     cout << "Total mutexes found backward: " << total_mutexes_bw << endl;
     return true;
@@ -239,7 +323,7 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
         //  cout << i << "-" << num_vals[i] << endl;
     }
     //Initialize everything to NOT_REACHED (mutexes will be set to spurious)
-    m_values.resize(number_props * number_props, NOT_REACHED);
+    m_values.resize(number_props, NOT_REACHED);
 
     //Set to spurious variables with themselves
     for (int var = 0; var < num_vars; ++var) {
@@ -247,10 +331,7 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
             int p_index_1 = p_index[var][val1];
             for (int val2 = val1 + 1; val2 < num_vals[var]; ++val2) {
                 int p_index_2 = p_index[var][val2];
-                int pos1 = position(p_index_1, p_index_2);
-                int pos2 = position(p_index_2, p_index_1);
-                m_values[pos1] = SPURIOUS;
-                m_values[pos2] = SPURIOUS;
+                m_values.set(p_index_1, p_index_2, SPURIOUS);
             }
         }
     }
@@ -290,8 +371,7 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
                     //cout << "Initialize mutex: " << var1 <<"-" << val1 << " "  << variables[var1]->get_fact_name(val1) << " - " << var2<< "-" << val2 << " "  << variables[var2]->get_fact_name(val2) << endl;
 
                     // set the pairs that are mutex as spurious
-                    m_values[position(p_index[var1][val1], p_index[var2][val2])] = SPURIOUS;
-                    m_values[position(p_index[var2][val2], p_index[var1][val1])] = SPURIOUS;
+                    m_values.set(p_index[var1][val1], p_index[var2][val2], SPURIOUS);
                 }
             }
         }
@@ -304,23 +384,17 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
     //         for (unsigned j = 0; j < g_variable_domain[i]; j++)
     //             m_values[position(p_index[i][j], p_index[it->first][it->second])] = m_values[position(p_index[it->first][it->second], p_index[i][j])] = SPURIOUS;
 
-    cout << "Mutex computation initialized with " << number_props << " fluents." << endl;
+    cout << "Mutex computation initialized with " << number_props << " fluents ("
+         << m_values.memory_in_bytes() / 1024 << " KB for the pair matrix)." << endl;
     return true;
 }
 
 
 bool H2Mutexes::init_values_progression(const vector <Variable *> &variables,
-                                        const State &initial_state) {
-    int countSpurious = 0, countReached = 0, countNotReached = 0;
-
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == SPURIOUS) {
-            countSpurious++;
-            continue;
-        }
-        m_values[i] = NOT_REACHED;
-        countNotReached++;
-    }
+                                        const State &initial_state, ostream &log) {
+    m_values.replace(REACHED, NOT_REACHED);
+    size_t countSpurious = m_values.count(SPURIOUS);
+    size_t countReached = 0, countNotReached = m_values.size() - countSpurious;
 
     for (unsigned i = 0; i < variables.size(); i++) {
         int var1 = variables[i]->get_level();
@@ -328,19 +402,19 @@ bool H2Mutexes::init_values_progression(const vector <Variable *> &variables,
         for (unsigned j = 0; j < variables.size(); j++) {
             int var2 = variables[j]->get_level();
             unsigned fluent2 = p_index[var2][initial_state[variables[j]]];
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS)
+            Reachability value = m_values.get(fluent1, fluent2);
+            if (value == SPURIOUS)
                 return false;
             //This check probably is unnecessary, because the initial state should not contain anything spurious
             // (I left it just in case of unsolvable problems)
-            if (m_values[pos] == NOT_REACHED) {
-                m_values[pos] = REACHED;
+            if (value == NOT_REACHED) {
+                m_values.set(fluent1, fluent2, REACHED);
                 countReached++;
                 countNotReached--;
             }
         }
     }
-    cout << "Initialized mvalues forward: reached=" << countReached <<
+    log << "Initialized mvalues forward: reached=" << countReached <<
         ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
 
     return true;
@@ -355,8 +429,7 @@ bool H2Mutexes::check_initial_state_is_dead_end(const vector <Variable *> &varia
         for (unsigned j = 0; j < variables.size(); j++) {
             int var2 = variables[j]->get_level();
             unsigned fluent2 = p_index[var2][initial_state[variables[j]]];
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS) {
+            if (m_values.get(fluent1, fluent2) == SPURIOUS) {
                 return true;
             }
         }
@@ -373,8 +446,7 @@ bool H2Mutexes::check_goal_state_is_unreachable(const vector<pair<Variable *, in
             int var2 = goal[g2].first->get_level();
             unsigned fluent2 = p_index[var2][goal[g2].second];
 
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS) {
+            if (m_values.get(fluent1, fluent2) == SPURIOUS) {
                 return true;
             }
         }
@@ -384,17 +456,14 @@ bool H2Mutexes::check_goal_state_is_unreachable(const vector<pair<Variable *, in
 
 
 
-bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal) {
-    cout << "Init values regression" << endl;
+bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal,
+                                       ostream &log) {
+    log << "Init values regression" << endl;
 
     if (check_goal_state_is_unreachable(goal))
         return false;
 
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] != SPURIOUS) {
-            m_values[i] = REACHED;
-        }
-    }
+    m_values.replace(NOT_REACHED, REACHED);
 
     // the things that are mutex with the goal are not reached
     for (unsigned g = 0; g < goal.size(); g++) {
@@ -413,35 +482,20 @@ bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal
         }
     }
 
-    int countSpurious = 0, countReached = 0, countNotReached = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == REACHED) {
-            countReached++;
-        } else if (m_values[i] == NOT_REACHED) {
-            countNotReached++;
-        } else {
-            countSpurious++;
-        }
-    }
+    size_t countReached = m_values.count(REACHED);
+    size_t countNotReached = m_values.count(NOT_REACHED);
+    size_t countSpurious = m_values.size() - countReached - countNotReached;
 
-    cout << "Initialized mvalues backward: reached=" << countReached <<
+    log << "Initialized mvalues backward: reached=" << countReached <<
         ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
 
     return true;
 }
 
 void H2Mutexes::setPropositionNotReached(int prop_index) {
-    for (int var2 = 0; var2 < num_vars; var2++) {
-        for (int val2 = 0; val2 < num_vals[var2]; val2++) {
-            int p_index_2 = p_index[var2][val2];
-            int pos1 = position(prop_index, p_index_2);
-            if (m_values[pos1] == REACHED) {
-                m_values[pos1] = NOT_REACHED;
-            }
-            int pos2 = position(p_index_2, prop_index);
-            if (m_values[pos2] == REACHED) {
-                m_values[pos2] = NOT_REACHED;
-            }
+    for (unsigned p = 0; p < number_props; p++) {
+        if (m_values.get(prop_index, p) == REACHED) {
+            m_values.set(prop_index, p, NOT_REACHED);
         }
     }
 }
@@ -460,6 +514,54 @@ void H2Mutexes::init_h2_operators(const vector<Operator> &operators, const vecto
     }
 }
 
+template<typename ReachPair>
+void H2Mutexes::apply_op(const Op_h2 &op, ReachPair reach_pair) const {
+    for (unsigned p : op.add) {
+        for (unsigned q : op.add) {
+            if (m_values.get(p, q) == NOT_REACHED) {
+                reach_pair(p, q);
+            }
+        }
+    }
+    for (unsigned prop_i = 0; prop_i < number_props; prop_i++) {
+        apply_op(op, prop_i, reach_pair);
+    }
+}
+
+template<typename ReachPair>
+void H2Mutexes::apply_op(const Op_h2 &op, unsigned prop, ReachPair reach_pair) const {
+    // Most pairs are typically reached already, so check this first
+    bool new_pair = false;
+    for (unsigned p : op.add) {
+        if (m_values.get(p, prop) == NOT_REACHED) {
+            new_pair = true;
+            break;
+        }
+    }
+    if (!new_pair || m_values.get(prop, prop) != REACHED)
+        return;
+
+    if (binary_search(op.add.begin(), op.add.end(), prop) ||
+        binary_search(op.del.begin(), op.del.end(), prop)) {
+        return;
+    }
+
+    for (unsigned pre : op.pre) {
+        if (m_values.get(prop, pre) != REACHED)
+            return;
+    }
+
+    for (unsigned p : op.add) {
+        if (m_values.get(p, prop) == NOT_REACHED) {
+            // pair<unsigned, unsigned> a = p_index_reverse[prop];
+            // pair<unsigned, unsigned> b = p_index_reverse[p];
+            // cout << "Action: " << g_operators[op_i].get_name() << " -> ";
+            // cout << print_fluent(a.first,a.second) << " - " << print_fluent(b.first,b.second) << endl;
+            reach_pair(p, prop);
+        }
+    }
+}
+
 //Returns the number of new mutexes or -1 if failed
 int H2Mutexes::compute(const vector <Variable *> &variables,
                        vector<Operator> &operators,  //operators is not const because they may be detected as spurious
@@ -468,96 +570,238 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
                        const vector<pair<Variable *, int>> &goal,
                        vector<MutexGroup> &mutexes,
                        bool regression) {
-    cout << "Initialize m_index " << (regression ? "bw" : "fw") << endl;
+    int result = compute_reachability(variables, operators, axioms, initial_state, goal, regression, cout);
+    if (result == TIMEOUT || result == UNSOLVABLE)
+        return result;
+    return extract_mutexes(variables, operators, initial_state, goal, mutexes, regression);
+}
+
+//Returns 0, or UNSOLVABLE or TIMEOUT if failed
+int H2Mutexes::compute_reachability(const vector <Variable *> &variables,
+                                    const vector<Operator> &operators,
+                                    const vector<Axiom> &axioms,
+                                    const State &initial_state,
+                                    const vector<pair<Variable *, int>> &goal,
+                                    bool regression, ostream &log) {
+    log << "Initialize m_index " << (regression ? "bw" : "fw") << endl;
     if (regression) {
-        if (!init_values_regression(goal))
+        if (!init_values_regression(goal, log))
             return UNSOLVABLE;
     } else {
-        if (!init_values_progression(variables, initial_state))
+        if (!init_values_progression(variables, initial_state, log))
             return UNSOLVABLE;
     }
-    cout << "Initialize m_ops " << (regression ? "bw" : "fw") << endl;
+    log << "Initialize m_ops " << (regression ? "bw" : "fw") << endl;
     init_h2_operators(operators, axioms, regression);
 
-    cout << "Computing mutexes..." << endl;
+    log << "Computing mutexes..." << endl;
+
+    // Worklist fixpoint: every operator is applied to all propositions
+    // once it is triggered. Afterwards, a new pair (p, q) can only enable
+    // it for q if p is one of its preconditions (or for p if the operator
+    // has no preconditions and p = q: a pair is never reached before both
+    // of its propositions are). So instead of re-scanning all operators,
+    // the newly reached pairs are propagated to those operators only.
+    ops_by_pre.assign(number_props, vector<unsigned>());
+    ops_without_pre.clear();
+    pair_queue.clear();
+    for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
+        const Op_h2 &op = m_ops[op_i];
+        if (op.triggered == SPURIOUS)
+            continue;
+        if (op.pre.empty())
+            ops_without_pre.push_back(op_i);
+        for (unsigned p : op.pre)
+            ops_by_pre[p].push_back(op_i);
+    }
 
-    bool updated;
-    do {
-        // if (time_exceeded())
-        //     return TIMEOUT;
+    if (!(num_threads > 1 ? propagate_in_parallel() : propagate()))
+        return TIMEOUT;
 
-        updated = false;
-        for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
-            if (op_i % 10000 == 0 && time_exceeded())
-                return TIMEOUT;
+    size_t countReached = m_values.count(REACHED);
+    size_t countNotReached = m_values.count(NOT_REACHED);
+    size_t countSpurious = m_values.size() - countReached - countNotReached;
+    log << "Mutex computation finished with reached=" << countReached <<
+        ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
+    return 0;
+}
 
-            // disregard spurious operators
-            if (m_ops[op_i].triggered == SPURIOUS)
-                continue;
+bool H2Mutexes::propagate() {
+    for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
+        Op_h2 &op = m_ops[op_i];
+        if (op_i % 10000 == 0 && time_exceeded())
+            return false;
+        if (op.triggered != SPURIOUS &&
+            (op.triggered = eval_propositions(op.pre)) == REACHED)
+            apply_op(op, [this](unsigned p, unsigned q) {set_reached(p, q);});
+    }
 
-            // if the preconditions haven't been met, continue
-            if ((m_ops[op_i].triggered != REACHED) &&
-                ((m_ops[op_i].triggered =
-                      eval_propositions(m_ops[op_i].pre)) != REACHED))
-                continue;
+    size_t num_propagated = 0;
+    while (!pair_queue.empty()) {
+        if (++num_propagated % 10000 == 0 && time_exceeded())
+            return false;
+        unsigned p = pair_queue.front().first;
+        unsigned q = pair_queue.front().second;
+        pair_queue.pop_front();
+        for (unsigned op_i : ops_by_pre[p])
+            update_op(op_i, q);
+        if (p == q) {
+            for (unsigned op_i : ops_without_pre)
+                update_op(op_i, p);
+        } else {
+            for (unsigned op_i : ops_by_pre[q])
+                update_op(op_i, p);
+        }
+    }
+    return true;
+}
 
+/*
+  Runs work(begin, end, thread_id) on num_threads consecutive chunks of
+  [0, size), in the calling thread and num_threads - 1 new threads.
+*/
+template<typename Work>
+static void run_in_chunks(size_t size, int num_threads, Work work) {
+    size_t chunk_size = (size + num_threads - 1) / num_threads;
+    vector<thread> threads;
+    for (int t = 1; t < num_threads && t * chunk_size < size; ++t) {
+        threads.emplace_back(work, t * chunk_size, min(size, (t + 1) * chunk_size), t);
+    }
+    work(0, min(size, chunk_size), 0);
+    for (thread &t : threads)
+        t.join();
+}
 
-            for (unsigned add_i = 0; add_i < m_ops[op_i].add.size(); add_i++) {
-                unsigned p = m_ops[op_i].add[add_i];
-                for (unsigned add_j = 0; add_j < m_ops[op_i].add.size(); add_j++) {
-                    unsigned q = m_ops[op_i].add[add_j];
-                    if (m_values[position(p, q)] == NOT_REACHED) {
-                        m_values[position(p, q)] = m_values[position(q, p)] = REACHED;
-                        updated = true;
+/*
+  Same fixpoint as propagate(), but the pairs in the queue are processed
+  layer by layer. The operators relevant for the pairs of a layer are
+  evaluated by several threads against the matrix of the previous layer
+  (which is not modified meanwhile), and the new pairs and triggered
+  operators found by each thread are merged afterwards. Every pair reached
+  in the merge is queued for the next layer, so no operator application is
+  missed. Operators triggered in a layer are then applied to all
+  propositions, also in parallel.
+*/
+bool H2Mutexes::propagate_in_parallel() {
+    // Layers with fewer items per thread are processed sequentially
+    const size_t MIN_CHUNK_SIZE = 256;
+
+    // Pairs reached and operators triggered by a thread in the current
+    // layer, with flags (by index in the matrix and in m_ops) to avoid
+    // duplicates
+    struct LayerResult {
+        vector<pair<unsigned, unsigned>> pairs;
+        vector<bool> has_pair;
+        vector<unsigned> ops;
+        vector<bool> has_op;
+    };
+    vector<LayerResult> results(num_threads);
+    for (LayerResult &result : results) {
+        result.has_pair.assign(m_values.size(), false);
+        result.has_op.assign(m_ops.size(), false);
+    }
+    vector<unsigned> triggered_ops;
+
+    auto process_layer = [&](size_t size, auto visit_item) {
+            int threads = max<size_t>(1, min<size_t>(num_threads, size / MIN_CHUNK_SIZE));
+            run_in_chunks(size, threads, [&](size_t begin, size_t end, int t) {
+                              LayerResult &result = results[t];
+                              auto reach_pair = [&](unsigned p, unsigned q) {
+                                                    size_t index = m_values.index(p, q);
+                                                    if (!result.has_pair[index]) {
+                                                        result.has_pair[index] = true;
+                                                        result.pairs.emplace_back(p, q);
+                                                    }
+                                                };
+                              for (size_t i = begin; i < end; ++i)
+                                  visit_item(i, result, reach_pair);
+                          });
+            for (int t = 0; t < threads; ++t) {
+                LayerResult &result = results[t];
+                for (unsigned op_i : result.ops) {
+                    result.has_op[op_i] = false;
+                    if (m_ops[op_i].triggered == NOT_REACHED) {
+                        m_ops[op_i].triggered = REACHED;
+                        triggered_ops.push_back(op_i);
                     }
                 }
-
-
-                for (unsigned prop_i = 0; prop_i < number_props; prop_i++) {
-                    if (m_values[position(prop_i, prop_i)] != REACHED ||
-                        m_values[position(p, prop_i)] != NOT_REACHED)
-                        continue;
-
-                    if (binary_search(m_ops[op_i].add.begin(),
-                                      m_ops[op_i].add.end(),
-                                      prop_i) ||
-                        binary_search(m_ops[op_i].del.begin(),
-                                      m_ops[op_i].del.end(),
-                                      prop_i)) {
-                        continue;
-                    }
-
-                    bool satisfied = true;
-                    for (unsigned pre_i = 0; satisfied && pre_i < m_ops[op_i].pre.size(); pre_i++) {
-                        satisfied = (m_values[position(prop_i, m_ops[op_i].pre[pre_i])] == REACHED);
-                    }
-
-                    if (satisfied) {
-                        // pair<unsigned, unsigned> a = p_index_reverse[prop_i];
-                        // pair<unsigned, unsigned> b = p_index_reverse[p];
-                        // cout << "Action: " << g_operators[op_i].get_name() << " -> ";
-                        // cout << print_fluent(a.first,a.second) << " - " << print_fluent(b.first,b.second) << endl;
-                        m_values[position(p, prop_i)] = m_values[position(prop_i, p)] = REACHED;
-                        updated = true;
-                    }
+                for (const auto &pair : result.pairs) {
+                    size_t index = m_values.index(pair.first, pair.second);
+                    result.has_pair[index] = false;
+                    if (m_values.get_entry(index) == NOT_REACHED)
+                        set_reached(pair.first, pair.second);
                 }
+                result.ops.clear();
+                result.pairs.clear();
             }
-        }
-    } while (updated);
+        };
+
+    auto trigger_op = [&](unsigned op_i, LayerResult &result) {
+            const Op_h2 &op = m_ops[op_i];
+            if (op.triggered == NOT_REACHED && !result.has_op[op_i] &&
+                eval_propositions(op.pre) == REACHED) {
+                result.has_op[op_i] = true;
+                result.ops.push_back(op_i);
+            }
+        };
+
+    auto apply_triggered_ops = [&]() {
+            vector<unsigned> ops;
+            ops.swap(triggered_ops);
+            process_layer(ops.size(), [&](size_t i, LayerResult &, auto &reach_pair) {
+                              apply_op(m_ops[ops[i]], reach_pair);
+                          });
+        };
+
+    // Operators that may be triggered by a pair with prop, or are
+    // triggered and may be applied to prop
+    auto visit_op = [&](unsigned op_i, unsigned prop, LayerResult &result,
+                        auto &reach_pair) {
+            const Op_h2 &op = m_ops[op_i];
+            if (op.triggered == REACHED) {
+                apply_op(op, prop, reach_pair);
+            } else if (binary_search(op.pre.begin(), op.pre.end(), prop)) {
+                trigger_op(op_i, result);
+            }
+        };
 
-    int countReached = 0, countNotReached = 0, countSpurious = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == REACHED) {
-            countReached++;
-        } else if (m_values[i] == NOT_REACHED) {
-            countNotReached++;
-        } else {
-            countSpurious++;
-        }
+    if (time_exceeded())
+        return false;
+    process_layer(m_ops.size(), [&](size_t op_i, LayerResult &result, auto &) {
+                      trigger_op(op_i, result);
+                  });
+    apply_triggered_ops();
+
+    while (!pair_queue.empty()) {
+        if (time_exceeded())
+            return false;
+        vector<pair<unsigned, unsigned>> layer(pair_queue.begin(), pair_queue.end());
+        pair_queue.clear();
+        process_layer(layer.size(), [&](size_t i, LayerResult &result, auto &reach_pair) {
+                          unsigned p = layer[i].first;
+                          unsigned q = layer[i].second;
+                          for (unsigned op_i : ops_by_pre[p])
+                              visit_op(op_i, q, result, reach_pair);
+                          if (p == q) {
+                              for (unsigned op_i : ops_without_pre)
+                                  visit_op(op_i, p, result, reach_pair);
+                          } else {
+                              for (unsigned op_i : ops_by_pre[q])
+                                  visit_op(op_i, p, result, reach_pair);
+                          }
+                      });
+        apply_triggered_ops();
     }
-    cout << "Mutex computation finished with reached=" << countReached <<
-        ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
+    return true;
+}
 
+//Returns the number of new mutexes or UNSOLVABLE
+int H2Mutexes::extract_mutexes(const vector <Variable *> &variables,
+                               vector<Operator> &operators,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goal,
+                               vector<MutexGroup> &mutexes,
+                               bool regression) {
     int numSpuriousOps = 0;
     for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
         if (m_ops[op_i].triggered == NOT_REACHED) {
@@ -571,11 +815,13 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
     //Add mutexes
     unsigned count = 0;
     int countUnreachable = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == NOT_REACHED) {
-            m_values[i] = SPURIOUS;
-            pair<unsigned, unsigned> a = p_index_reverse[i / number_props];
-            pair<unsigned, unsigned> b = p_index_reverse[i % number_props];
+    for (unsigned i = 0; i < number_props; i++) {
+        for (unsigned j = i; j < number_props; j++) {
+            if (m_values.get(i, j) != NOT_REACHED)
+                continue;
+            m_values.set(i, j, SPURIOUS);
+            pair<unsigned, unsigned> a = p_index_reverse[i];
+            pair<unsigned, unsigned> b = p_index_reverse[j];
             if (a == b) {
                 if (!is_unreachable(a.first, a.second)) {
                     countUnreachable++;
@@ -584,19 +830,18 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
                     }
                 }
             } else {
-                if (m_values[position(p_index[a.first][a.second], p_index[a.first][a.second])] == REACHED &&
-                    m_values[position(p_index[b.first][b.second], p_index[b.first][b.second])] == REACHED) {
+                if (m_values.get(i, i) == REACHED && m_values.get(j, j) == REACHED) {
                     // cout << "Mutex: " << variables[a.first]->get_fact_name(a.second) << " and "
                     //      << variables[b.first]->get_fact_name(b.second) << endl;
                     //Only increase the mutex count when both fluents are reachable
                     count++;
-                    // add to mutex groups
-                    if (a.first < b.first) {
-                        vector <pair <int, int>> mut_group;
-                        mut_group.push_back(make_pair(a.first, a.second));
-                        mut_group.push_back(make_pair(b.first, b.second));
-                        mutexes.push_back(MutexGroup(mut_group, variables, regression));
-                    }
+                    // add to mutex groups (i < j and facts of the same
+                    // variable are always spurious, so a.first < b.first)
+                    assert(a.first < b.first);
+                    vector <pair <int, int>> mut_group;
+                    mut_group.push_back(make_pair(a.first, a.second));
+                    mut_group.push_back(make_pair(b.first, b.second));
+                    mutexes.push_back(MutexGroup(mut_group, variables, regression));
                     // add to inconsistent
                     inconsistent_facts[a.first][a.second].insert(b);
                     inconsistent_facts[b.first][b.second].insert(a);
@@ -622,25 +867,54 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
     return count + countUnreachable;
 }
 
-Reachability H2Mutexes::eval_propositions(const vector<unsigned> &props) {
+Reachability H2Mutexes::eval_propositions(const vector<unsigned> &props) const {
     if (props.empty())
         return REACHED;
     for (unsigned i = 0; i < props.size(); i++)
         for (unsigned j = i; j < props.size(); j++)
-            if (m_values[position(props[i], props[j])] == NOT_REACHED)
+            if (m_values.get(props[i], props[j]) == NOT_REACHED)
                 return NOT_REACHED;
     return REACHED;
 }
 
+void H2Mutexes::set_reached(unsigned p, unsigned q) {
+    m_values.set(p, q, REACHED);
+    pair_queue.emplace_back(p, q);
+}
+
+void H2Mutexes::update_op(unsigned op_i, unsigned prop) {
+    Op_h2 &op = m_ops[op_i];
+    auto reach_pair = [this](unsigned p, unsigned q) {set_reached(p, q);};
+    if (op.triggered == REACHED) {
+        apply_op(op, prop, reach_pair);
+    } else if (op.triggered == NOT_REACHED &&
+               binary_search(op.pre.begin(), op.pre.end(), prop) &&
+               (op.triggered = eval_propositions(op.pre)) == REACHED) {
+        // Only a pair of two preconditions can trigger the operator
+        apply_op(op, reach_pair);
+    }
+}
+
+void H2Mutexes::adopt_reachability(H2Mutexes &other) {
+    assert(other.m_values.size() == m_values.size());
+    for (size_t i = 0; i < m_values.size(); ++i) {
+        if (m_values.get_entry(i) != SPURIOUS)
+            m_values.set_entry(i, other.m_values.get_entry(i));
+    }
+    m_ops.swap(other.m_ops);
+}
+
 void H2Mutexes::print_mutexes(const vector <Variable *> &variables) {
     unsigned count = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == SPURIOUS) {
-            pair<unsigned, unsigned> a = p_index_reverse[i / number_props];
-            pair<unsigned, unsigned> b = p_index_reverse[i % number_props];
-            if (!are_mutex(a.first, a.second, b.first, b.second)) {
-                count++;
-                cout << variables[a.first]->get_fact_name(a.second) << " - " << variables[b.first]->get_fact_name(b.second) << endl;
+    for (unsigned i = 0; i < number_props; i++) {
+        for (unsigned j = i; j < number_props; j++) {
+            if (m_values.get(i, j) == SPURIOUS) {
+                pair<unsigned, unsigned> a = p_index_reverse[i];
+                pair<unsigned, unsigned> b = p_index_reverse[j];
+                if (!are_mutex(a.first, a.second, b.first, b.second)) {
+                    count++;
+                    cout << variables[a.first]->get_fact_name(a.second) << " - " << variables[b.first]->get_fact_name(b.second) << endl;
+                }
             }
         }
     }
@@ -3,7 +3,9 @@
 #ifndef H2_MUTEXES_H
 #define H2_MUTEXES_H
 
+#include <cstdint>
 #include <ctime>
+#include <deque>
 #include <iostream>
 #include <algorithm>
 #include <string>
@@ -23,6 +25,86 @@ enum Reachability {SPURIOUS, REACHED, NOT_REACHED};
 static const int UNSOLVABLE = -2;
 static const int  TIMEOUT = -1;
 
+/*
+  Reachability of every unordered pair of propositions (including the pairs
+  of a proposition with itself), packed with 2 bits per pair. Only the upper
+  triangle of the (symmetric) matrix is stored, so it needs n(n+1)/4 bytes
+  instead of the 4n^2 bytes of a full matrix of unsigned values.
+*/
+class H2PairMatrix {
+    static const int BITS_PER_ENTRY = 2;
+    static const int ENTRIES_PER_WORD = 64 / BITS_PER_ENTRY;
+
+    size_t num_props;
+    size_t num_entries;
+    vector<uint64_t> words;
+    // index(a, b) = row_start[a] + b for a <= b
+    vector<size_t> row_start;
+
+    inline static int shift(size_t index) {
+        return (index % ENTRIES_PER_WORD) * BITS_PER_ENTRY;
+    }
+
+public:
+    H2PairMatrix() : num_props(0), num_entries(0) {}
+
+    void resize(size_t n, Reachability value) {
+        num_props = n;
+        num_entries = n * (n + 1) / 2;
+        uint64_t pattern = 0;
+        for (int i = 0; i < ENTRIES_PER_WORD; ++i)
+            pattern |= uint64_t(value) << (i * BITS_PER_ENTRY);
+        words.assign((num_entries + ENTRIES_PER_WORD - 1) / ENTRIES_PER_WORD, pattern);
+        row_start.resize(n);
+        for (size_t a = 0; a < n; ++a)
+            row_start[a] = a * (2 * n - a + 1) / 2 - a;
+    }
+
+    // Position of the pair in row-major order of the upper triangle
+    inline size_t index(size_t a, size_t b) const {
+        return a <= b ? row_start[a] + b : row_start[b] + a;
+    }
+
+    inline size_t size() const {
+        return num_entries;
+    }
+
+    inline Reachability get_entry(size_t index) const {
+        return Reachability((words[index / ENTRIES_PER_WORD] >> shift(index)) & 3);
+    }
+
+    inline void set_entry(size_t index, Reachability value) {
+        uint64_t &word = words[index / ENTRIES_PER_WORD];
+        word = (word & ~(uint64_t(3) << shift(index))) | (uint64_t(value) << shift(index));
+    }
+
+    inline Reachability get(size_t a, size_t b) const {
+        return get_entry(index(a, b));
+    }
+
+    inline void set(size_t a, size_t b, Reachability value) {
+        set_entry(index(a, b), value);
+    }
+
+    void replace(Reachability old_value, Reachability new_value) {
+        for (size_t i = 0; i < num_entries; ++i)
+            if (get_entry(i) == old_value)
+                set_entry(i, new_value);
+    }
+
+    size_t count(Reachability value) const {
+        size_t result = 0;
+        for (size_t i = 0; i < num_entries; ++i)
+            if (get_entry(i) == value)
+                ++result;
+        return result;
+    }
+
+    size_t memory_in_bytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+};
+
 class Op_h2 {
 public:
     Op_h2(const Operator &op,
@@ -61,12 +143,16 @@ class H2Mutexes {
 
     bool check_goal_state_is_unreachable(const vector<pair<Variable *, int>> &goal) const;
 public:
-    H2Mutexes(int t = -1) : limit_seconds(t) {
+    H2Mutexes(int t = -1, int threads = 1) : num_threads(threads), limit_seconds(t) {
         if (limit_seconds != -1)
             time(&start);
     }
     virtual ~H2Mutexes() {}
 
+    void set_num_threads(int threads) {
+        num_threads = threads;
+    }
+
     int compute(const vector <Variable *> &variables,
                 vector<Operator> &operators, //not const because may be detected to be spurious
                 const vector<Axiom> &axioms,
@@ -75,6 +161,29 @@ public:
                 vector<MutexGroup> &mutexes,
                 bool regression);
 
+    /*
+      compute() is split into two parts so that the forward and backward
+      computations can run concurrently on two copies of this object:
+      compute_reachability() only modifies this object (and writes its log
+      to the given stream), and extract_mutexes() updates the operators,
+      variables and mutexes of the task according to its result.
+    */
+    int compute_reachability(const vector <Variable *> &variables,
+                             const vector<Operator> &operators,
+                             const vector<Axiom> &axioms,
+                             const State &initial_state,
+                             const vector<pair<Variable *, int>> &goal,
+                             bool regression, ostream &log);
+    int extract_mutexes(const vector <Variable *> &variables,
+                        vector<Operator> &operators,
+                        const State &initial_state,
+                        const vector<pair<Variable *, int>> &goal,
+                        vector<MutexGroup> &mutexes,
+                        bool regression);
+    // Takes the reachability computed by other (a copy of this object)
+    // for all pairs that are not known to be spurious in this one
+    void adopt_reachability(H2Mutexes &other);
+
     void print_mutexes(const std::vector <Variable *> &variables);
 
     inline bool are_mutex(int var1, int val1, int var2, int val2) const {
@@ -85,7 +194,7 @@ public:
             return val1 != val2;  //TODO: || unreachable[var1][val1];
         unsigned p1 = p_index[var1][val1];
         unsigned p2 = p_index[var2][val2];
-        return m_values[position(p1, p2)] == SPURIOUS;
+        return m_values.get(p1, p2) == SPURIOUS;
     }
 
     inline int num_variables() const {
@@ -120,17 +229,40 @@ protected:
     std::vector<std::vector<std::set<std::pair<int, int>>>> inconsistent_facts;
 
     unsigned number_props;
-    vector<unsigned> m_values;
+    H2PairMatrix m_values;
     vector<Op_h2> m_ops;
 
+    // Operators whose precondition contains each proposition (and those
+    // without precondition), to revisit them when one of their
+    // precondition pairs is reached
+    vector<vector<unsigned>> ops_by_pre;
+    vector<unsigned> ops_without_pre;
+    // Pairs reached but not yet propagated
+    deque<pair<unsigned, unsigned>> pair_queue;
+
+    // Threads used to evaluate the operators in each pass
+    int num_threads;
+
     vector< vector<unsigned>> p_index;
     vector< pair<unsigned, unsigned>> p_index_reverse;
 
-    Reachability eval_propositions(const vector<unsigned> & props);
+    Reachability eval_propositions(const vector<unsigned> & props) const;
 
-    inline unsigned position(unsigned a, unsigned b) const {
-        return (a * number_props) + b;
-    }
+    void set_reached(unsigned p, unsigned q);
+    // Calls reach_pair for the pairs of the adds of a triggered operator
+    // with every proposition (or only with prop) that become reached
+    template<typename ReachPair>
+    void apply_op(const Op_h2 &op, ReachPair reach_pair) const;
+    template<typename ReachPair>
+    void apply_op(const Op_h2 &op, unsigned prop, ReachPair reach_pair) const;
+    // Called when a pair of prop with a precondition of the operator has
+    // been reached
+    void update_op(unsigned op_i, unsigned prop);
+
+    // Fixpoint of the reached pairs, sequentially or evaluating the
+    // operators of each layer of new pairs with num_threads threads
+    bool propagate();
+    bool propagate_in_parallel();
 
     bool set_unreachable(int var, int val, const vector <Variable *> &variables, 
 			 const State &initial_state, 
@@ -143,8 +275,9 @@ protected:
     bool time_exceeded();
 
     bool init_values_progression(const vector <Variable *> &variables,
-                                 const State &initial_state);
-    bool init_values_regression(const vector<pair<Variable *, int>> &goal);
+                                 const State &initial_state, ostream &log);
+    bool init_values_regression(const vector<pair<Variable *, int>> &goal,
+                                ostream &log);
     void init_h2_operators(const vector<Operator> &operators,
                            const vector<Axiom> &axioms, bool regression);
 
@@ -158,7 +291,8 @@ extern bool compute_h2_mutexes(const vector <Variable *> &variables,
                                vector<MutexGroup> &mutexes,
                                State &initial_state,
                                const vector<pair<Variable *, int>> &goal,
-                               int limit_seconds, bool disable_bw_h2);
+                               int limit_seconds, bool disable_bw_h2,
+                               int num_threads = 1);
 
 
 
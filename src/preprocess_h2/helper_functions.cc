@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -17,6 +19,9 @@ using namespace std;
 
 static const int SAS_FILE_VERSION = 3;
 static const int PRE_FILE_VERSION = SAS_FILE_VERSION;
+// Must match task_representation/binary_task_reader.h in the search code
+static const char BINARY_FILE_MAGIC[] = "SASBIN";
+static const int BINARY_FILE_VERSION = 1;
 
 
 void check_magic(istream &in, string magic) {
@@ -202,6 +207,66 @@ void generate_cpp_input(const vector<Variable *> &ordered_vars,
 
     outfile.close();
 }
+void write_binary_int(ostream &out, int value) {
+    uint32_t bits = value;
+    char bytes[4];
+    for (int i = 0; i < 4; ++i)
+        bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+    out.write(bytes, 4);
+}
+
+void write_binary_string(ostream &out, const string &value) {
+    write_binary_int(out, value.size());
+    out.write(value.data(), value.size());
+}
+
+void generate_binary_cpp_input(const vector<Variable *> &ordered_vars,
+                               const bool &metric,
+                               const vector<MutexGroup> &mutexes,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goals,
+                               const vector<Operator> &operators,
+                               const vector<Axiom> &axioms) {
+    ofstream outfile;
+    outfile.open("output.sas", ios::out | ios::binary);
+
+    outfile.write(BINARY_FILE_MAGIC, sizeof(BINARY_FILE_MAGIC));
+    write_binary_int(outfile, BINARY_FILE_VERSION);
+    write_binary_int(outfile, metric);
+
+    write_binary_int(outfile, ordered_vars.size());
+    for (Variable *var : ordered_vars)
+        var->generate_binary_cpp_input(outfile);
+
+    write_binary_int(outfile, mutexes.size());
+    for (const MutexGroup &mutex : mutexes)
+        mutex.generate_binary_cpp_input(outfile);
+
+    write_binary_int(outfile, ordered_vars.size());
+    for (Variable *var : ordered_vars)
+        write_binary_int(outfile, initial_state[var]);
+
+    vector<pair<int, int>> ordered_goals;
+    for (const auto &goal : goals)
+        ordered_goals.emplace_back(goal.first->get_level(), goal.second);
+    sort(ordered_goals.begin(), ordered_goals.end());
+    write_binary_int(outfile, ordered_goals.size());
+    for (const auto &goal : ordered_goals) {
+        write_binary_int(outfile, goal.first);
+        write_binary_int(outfile, goal.second);
+    }
+
+    write_binary_int(outfile, operators.size());
+    for (const Operator &op : operators)
+        op.generate_binary_cpp_input(outfile);
+
+    write_binary_int(outfile, axioms.size());
+    for (const Axiom &axiom : axioms)
+        axiom.generate_binary_cpp_input(outfile);
+
+    outfile.close();
+}
+
 void generate_unsolvable_cpp_input() {
     ofstream outfile;
     outfile.open("output.sas", ios::out);
@@ -41,6 +41,20 @@ void generate_cpp_input(const vector<Variable *> &ordered_var,
                         const vector<pair<Variable *, int>> &goals,
                         const vector<Operator> &operators,
                         const vector<Axiom> &axioms);
+/*
+  Writes the same task as generate_cpp_input in the binary format read by
+  the search component (see task_representation/binary_task_reader.h).
+*/
+void generate_binary_cpp_input(const vector<Variable *> &ordered_var,
+                               const bool &metric,
+                               const vector<MutexGroup> &mutexes,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goals,
+                               const vector<Operator> &operators,
+                               const vector<Axiom> &axioms);
+// 32-bit little-endian integer and length-prefixed string
+void write_binary_int(ostream &out, int value);
+void write_binary_string(ostream &out, const string &value);
 void check_magic(istream & in, string magic);
 
 #endif
@@ -63,6 +63,14 @@ void MutexGroup::generate_cpp_input(ofstream &outfile) const {
     outfile << "end_mutex_group" << endl;
 }
 
+void MutexGroup::generate_binary_cpp_input(ofstream &outfile) const {
+    write_binary_int(outfile, facts.size());
+    for (const auto &fact : facts) {
+        write_binary_int(outfile, fact.first->get_level());
+        write_binary_int(outfile, fact.second);
+    }
+}
+
 void MutexGroup::strip_unimportant_facts() {
     int new_index = 0;
     for (const auto &fact : facts) {
@@ -93,6 +93,7 @@ public:
     void dump() const;
     int get_encoding_size() const;
     void generate_cpp_input(ofstream &outfile) const;
+    void generate_binary_cpp_input(ofstream &outfile) const;
     int get_cost() const {return cost; }
     string get_name() const {return name; }
     bool has_conditional_effects() const {
@@ -21,6 +21,8 @@ int main(int argc, const char **argv) {
     bool include_augmented_preconditions = false;
     bool expensive_statistics = false;
     bool disable_bw_h2 = false;
+    int h2_threads = 1;
+    bool binary_output = false;
 
     bool metric;
     vector<Variable *> variables;
@@ -49,6 +51,23 @@ int main(int argc, const char **argv) {
                 cerr << "please specify the number of seconds after --h2_time_limit" << endl;
                 exit(2);
             }
+        } else if (arg.compare("--threads") == 0) {
+            i++;
+            if (i < argc && atoi(argv[i]) > 0) {
+                h2_threads = atoi(argv[i]);
+            } else {
+                cerr << "please specify a positive number of threads after --threads" << endl;
+                exit(2);
+            }
+        } else if (arg.compare("--output_format") == 0) {
+            i++;
+            string format = i < argc ? argv[i] : "";
+            if (format == "text" || format == "binary") {
+                binary_output = format == "binary";
+            } else {
+                cerr << "please specify text or binary after --output_format" << endl;
+                exit(2);
+            }
         } else if (arg.compare("--no_h2") == 0) {
             h2_mutex_time = 0;
         } else if (arg.compare("--augmented_pre") == 0) {
@@ -59,7 +78,7 @@ int main(int argc, const char **argv) {
             expensive_statistics = true;
         } else {
             cerr << "unknown option " << arg << endl << endl;
-            cout << "Usage: ./preprocess [--no_rel] [--no_h2]  [--no_bw_h2] [--augmented_pre] [--stat] < output" << endl;
+            cout << "Usage: ./preprocess [--no_rel] [--no_h2]  [--no_bw_h2] [--augmented_pre] [--stat] [--threads N] [--output_format text|binary] < output" << endl;
             exit(2);
         }
     }
@@ -95,7 +114,7 @@ int main(int argc, const char **argv) {
 
         if (!compute_h2_mutexes(ordering, operators, axioms,
                                 mutexes, initial_state, goals,
-                                h2_mutex_time, disable_bw_h2)) {
+                                h2_mutex_time, disable_bw_h2, h2_threads)) {
             // TODO: don't duplicate the code to return an unsolvable task, log and exit here
             cout << "Unsolvable task in preprocessor" << endl;
             generate_unsolvable_cpp_input();
@@ -241,6 +260,9 @@ int main(int argc, const char **argv) {
     if (ordering.empty()) {
         cout << "Unsolvable task in preprocessor" << endl;
         generate_unsolvable_cpp_input();
+    } else if (binary_output) {
+        generate_binary_cpp_input(
+            ordering, metric, mutexes, initial_state, goals, operators, axioms);
     } else {
         generate_cpp_input(
             ordering, metric, mutexes, initial_state, goals, operators, axioms);
@@ -71,6 +71,15 @@ void Variable::generate_cpp_input(ofstream &outfile) const {
     outfile << "end_variable" << endl;
 }
 
+void Variable::generate_binary_cpp_input(ofstream &outfile) const {
+    write_binary_string(outfile, name);
+    write_binary_int(outfile, layer);
+    write_binary_int(outfile, reachable_values);
+    for (size_t i = 0; i < values.size(); ++i)
+        if (reachable[i])
+            write_binary_string(outfile, values[i]);
+}
+
 void Variable::remove_unreachable_facts() {
     vector<string> new_values;
     for (size_t i = 0; i < values.size(); i++) {
@@ -109,6 +109,7 @@ fast_downward_plugin(
         symbolic/uniform_cost_search
         symbolic/breadth_first_search
         symbolic/bidirectional_search
+        symbolic/parallel_bidirectional_search
         symbolic/state_reordering
         DEPENDS CAUSAL_GRAPH
         DEPENDENCY_ONLY
@@ -149,8 +150,10 @@ fast_downward_plugin(
     NAME TASK_REPRESENTATION
     HELP "Task representation"
     SOURCES
+        task_representation/binary_task_reader
         task_representation/fts_factory
         task_representation/fts_operators
+        task_representation/fts_successor_generator
         task_representation/fts_task
         task_representation/labels
         task_representation/label_equivalence_relation
@@ -158,6 +161,7 @@ fast_downward_plugin(
         task_representation/sas_task
         task_representation/search_task
         task_representation/state
+        task_representation/transition_list
         task_representation/transition_system
     CORE_PLUGIN
 )
@@ -167,6 +171,7 @@ fast_downward_plugin(
     NAME TASK_TRANSFORMATION
     HELP "Task transformation"
     SOURCES
+        task_transformation/bisimulation_partition_refinement
         task_transformation/distances
         task_transformation/factored_transition_system
         task_transformation/fts_factory
@@ -209,9 +214,12 @@ fast_downward_plugin(
         task_transformation/task_transformation_merge_and_shrink
         task_transformation/task_transformation_tau_path
         task_transformation/tau_graph
+        task_transformation/tau_reachability
+        task_transformation/transformation_cache
         task_transformation/types
         task_transformation/utils
         task_transformation/variable_order_finder
+        task_transformation/virtual_product
     CORE_PLUGIN
     DEPENDS EQUIVALENCE_RELATION DOMINANCE
 
@@ -243,6 +251,7 @@ fast_downward_plugin(
     HELP "System utilities"
     SOURCES
         utils/collections
+        utils/binary_io
         utils/countdown_timer
         utils/hash
         utils/language
@@ -255,6 +264,7 @@ fast_downward_plugin(
         utils/system
         utils/system_unix
         utils/system_windows
+        utils/thread_pool
         utils/timer
     CORE_PLUGIN
 )
@@ -266,6 +276,13 @@ fast_downward_plugin(
         open_lists/alternation_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open list with an array of buckets for small integer keys"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME EPSILON_GREEDY_OPEN_LIST
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -458,7 +475,7 @@ fast_downward_plugin(
     HELP "Basic classes used for all search engines"
     SOURCES
         search_engines/search_common
-    DEPENDS ALTERNATION_OPEN_LIST G_EVALUATOR STANDARD_SCALAR_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
+    DEPENDS ALTERNATION_OPEN_LIST BUCKET_OPEN_LIST G_EVALUATOR STANDARD_SCALAR_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
     DEPENDENCY_ONLY
 )
 
@@ -527,6 +544,14 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME HDA_STAR_SEARCH
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/hda_star_search
+    DEPENDS SEARCH_COMMON
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
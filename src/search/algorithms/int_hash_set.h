@@ -0,0 +1,146 @@
+#ifndef ALGORITHMS_INT_HASH_SET_H
+#define ALGORITHMS_INT_HASH_SET_H
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace int_hash_set {
+/*
+  Hash set of non-negative ints using open addressing with linear probing.
+
+  The keys are usually indices into some external storage (e.g. StateIDs
+  referring to states in a state registry), and the hash and equality
+  functions work on the external data. Every bucket stores the key
+  together with a 32-bit hash of the key, so that most unsuccessful
+  comparisons are decided without touching the external data and the
+  table can be grown without recomputing hashes.
+
+  Compared to std::unordered_set<int>, this uses 8 bytes per bucket and no
+  per-entry allocation. With the maximum load factor of 0.75, this amounts
+  to at most 21.3 bytes per entry directly after growing, and 10.7 bytes
+  directly before.
+
+  Hasher must map an int key to an integer (only the lower 32 bits are
+  used), Equal must compare two int keys.
+*/
+template<typename Hasher, typename Equal>
+class IntHashSet {
+    using HashType = std::uint32_t;
+
+    static const int EMPTY_KEY = -1;
+    static const int MIN_CAPACITY = 16;
+
+    struct Bucket {
+        int key;
+        HashType hash;
+
+        Bucket()
+            : key(EMPTY_KEY), hash(0) {
+        }
+    };
+
+    Hasher hasher;
+    Equal equal;
+    std::vector<Bucket> buckets;
+    int num_entries;
+    // Statistics
+    long long num_probes;
+    long long num_inserts;
+    int num_resizes;
+
+    int get_bucket_mask() const {
+        return buckets.size() - 1;
+    }
+
+    void place(const Bucket &bucket) {
+        int mask = get_bucket_mask();
+        int pos = bucket.hash & mask;
+        while (buckets[pos].key != EMPTY_KEY) {
+            pos = (pos + 1) & mask;
+        }
+        buckets[pos] = bucket;
+    }
+
+    void resize(int new_capacity) {
+        assert((new_capacity & (new_capacity - 1)) == 0);
+        std::vector<Bucket> old_buckets(new_capacity);
+        old_buckets.swap(buckets);
+        for (const Bucket &bucket : old_buckets) {
+            if (bucket.key != EMPTY_KEY) {
+                place(bucket);
+            }
+        }
+        ++num_resizes;
+    }
+
+public:
+    IntHashSet(const Hasher &hasher, const Equal &equal)
+        : hasher(hasher),
+          equal(equal),
+          buckets(MIN_CAPACITY),
+          num_entries(0),
+          num_probes(0),
+          num_inserts(0),
+          num_resizes(0) {
+    }
+
+    /*
+      Insert key unless an equal key is already contained. Return the
+      contained key and whether key has been inserted.
+    */
+    std::pair<int, bool> insert(int key) {
+        assert(key >= 0);
+        if (4LL * (num_entries + 1) > 3LL * static_cast<long long>(buckets.size())) {
+            resize(2 * buckets.size());
+        }
+        ++num_inserts;
+        HashType hash = static_cast<HashType>(hasher(key));
+        int mask = get_bucket_mask();
+        int pos = hash & mask;
+        while (true) {
+            ++num_probes;
+            Bucket &bucket = buckets[pos];
+            if (bucket.key == EMPTY_KEY) {
+                bucket.key = key;
+                bucket.hash = hash;
+                ++num_entries;
+                return std::make_pair(key, true);
+            } else if (bucket.hash == hash && equal(bucket.key, key)) {
+                return std::make_pair(bucket.key, false);
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    int size() const {
+        return num_entries;
+    }
+
+    int get_capacity() const {
+        return buckets.size();
+    }
+
+    std::size_t get_memory_in_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
+    void print_statistics() const {
+        std::cout << "Hash set entries: " << num_entries << std::endl;
+        std::cout << "Hash set buckets: " << buckets.size() << std::endl;
+        std::cout << "Hash set load factor: "
+                  << static_cast<double>(num_entries) / buckets.size() << std::endl;
+        std::cout << "Hash set bytes per entry: "
+                  << (num_entries ? static_cast<double>(get_memory_in_bytes()) / num_entries : 0.)
+                  << std::endl;
+        std::cout << "Hash set resizes: " << num_resizes << std::endl;
+        std::cout << "Hash set average probes per insertion: "
+                  << (num_inserts ? static_cast<double>(num_probes) / num_inserts : 0.)
+                  << std::endl;
+    }
+};
+}
+
+#endif
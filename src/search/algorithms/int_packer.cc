@@ -1,5 +1,6 @@
 #include "int_packer.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -62,6 +63,22 @@ public:
         Bin &bin = buffer[bin_index];
         bin = (bin & clear_mask) | (value << shift);
     }
+
+    int get_range() const {
+        return range;
+    }
+
+    int get_bin_index() const {
+        return bin_index;
+    }
+
+    int get_shift() const {
+        return shift;
+    }
+
+    Bin get_read_mask() const {
+        return read_mask;
+    }
 };
 
 
@@ -81,6 +98,36 @@ void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
 
+vector<IntPacker::BinAssignment> IntPacker::compute_bin_assignments(
+    const vector<pair<int, int>> &var_values) const {
+    vector<BinAssignment> assignments;
+    for (const pair<int, int> &var_value : var_values) {
+        const VariableInfo &info = var_infos[var_value.first];
+        assert(var_value.second >= 0 && var_value.second < info.get_range());
+        auto it = find_if(assignments.begin(), assignments.end(),
+                          [&](const BinAssignment &assignment) {
+                              return assignment.bin_index == info.get_bin_index();
+                          });
+        if (it == assignments.end()) {
+            assignments.push_back({info.get_bin_index(), ~Bin(0), 0});
+            it = assignments.end() - 1;
+        }
+        assert((it->clear_mask & info.get_read_mask()) == info.get_read_mask());
+        it->clear_mask &= ~info.get_read_mask();
+        it->value_bits |= Bin(var_value.second) << info.get_shift();
+    }
+    sort(assignments.begin(), assignments.end(),
+         [](const BinAssignment &lhs, const BinAssignment &rhs) {
+             return lhs.bin_index < rhs.bin_index;
+         });
+    return assignments;
+}
+
+IntPacker::VariableLocation IntPacker::get_variable_location(int var) const {
+    const VariableInfo &info = var_infos[var];
+    return {info.get_bin_index(), info.get_shift(), info.get_read_mask()};
+}
+
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
@@ -1,6 +1,7 @@
 #ifndef ALGORITHMS_INT_PACKER_H
 #define ALGORITHMS_INT_PACKER_H
 
+#include <utility>
 #include <vector>
 
 /*
@@ -30,6 +31,26 @@ class IntPacker {
 public:
     typedef unsigned int Bin;
 
+    /*
+      Sets all variables of one bin that are assigned by a
+      BinAssignment at once: bin = (bin & clear_mask) | value_bits.
+    */
+    struct BinAssignment {
+        int bin_index;
+        Bin clear_mask;
+        Bin value_bits;
+    };
+
+    /*
+      Position of a variable within the packed buffer, allowing to read and
+      write its value without going through the IntPacker.
+    */
+    struct VariableLocation {
+        int bin_index;
+        int shift;
+        Bin read_mask;
+    };
+
     /*
       The constructor takes the range for each variable. The domain of
       variable i is {0, ..., ranges[i] - 1}. Because we are using signed
@@ -42,6 +63,29 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Combine the given assignments (pairs of variable and value, each
+      variable occurring at most once) into one BinAssignment per bin
+      touched by them, sorted by bin index.
+    */
+    std::vector<BinAssignment> compute_bin_assignments(
+        const std::vector<std::pair<int, int>> &var_values) const;
+    VariableLocation get_variable_location(int var) const;
+
+    static void apply(Bin *buffer, const BinAssignment &assignment) {
+        Bin &bin = buffer[assignment.bin_index];
+        bin = (bin & assignment.clear_mask) | assignment.value_bits;
+    }
+
+    static int get(const Bin *buffer, const VariableLocation &location) {
+        return (buffer[location.bin_index] & location.read_mask) >> location.shift;
+    }
+
+    static void set(Bin *buffer, const VariableLocation &location, int value) {
+        Bin &bin = buffer[location.bin_index];
+        bin = (bin & ~location.read_mask) | (Bin(value) << location.shift);
+    }
+
     int get_num_bins() const {return num_bins; }
 };
 }
@@ -0,0 +1,75 @@
+#ifndef ALGORITHMS_PACKED_INT_VECTOR_H
+#define ALGORITHMS_PACKED_INT_VECTOR_H
+
+#include "segmented_vector.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace packed_int_vector {
+/*
+  Vector of unsigned ints that all use the same number of bits (at most
+  32), packed tightly into 64-bit words. An entry may span two words.
+  The words are stored in a SegmentedVector, so growing the vector has no
+  memory spike. New entries are 0.
+*/
+class PackedIntVector {
+    using Word = std::uint64_t;
+    static const int BITS_PER_WORD = 64;
+
+    int bits;
+    Word mask;
+    std::size_t the_size;
+    segmented_vector::SegmentedVector<Word> words;
+
+public:
+    explicit PackedIntVector(int bits)
+        : bits(bits),
+          mask((Word(1) << bits) - 1),
+          the_size(0) {
+        assert(bits >= 1 && bits <= 32);
+    }
+
+    std::size_t size() const {
+        return the_size;
+    }
+
+    int get_bits_per_entry() const {
+        return bits;
+    }
+
+    void resize(std::size_t new_size) {
+        assert(new_size >= the_size);
+        the_size = new_size;
+        std::size_t num_words = (the_size * bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        words.resize(num_words, 0);
+    }
+
+    unsigned int get(std::size_t index) const {
+        assert(index < the_size);
+        std::size_t bit = index * bits;
+        std::size_t word = bit / BITS_PER_WORD;
+        int offset = bit % BITS_PER_WORD;
+        Word value = words[word] >> offset;
+        if (offset + bits > BITS_PER_WORD) {
+            value |= words[word + 1] << (BITS_PER_WORD - offset);
+        }
+        return value & mask;
+    }
+
+    void set(std::size_t index, unsigned int value) {
+        assert(index < the_size);
+        assert((Word(value) & ~mask) == 0);
+        std::size_t bit = index * bits;
+        std::size_t word = bit / BITS_PER_WORD;
+        int offset = bit % BITS_PER_WORD;
+        words[word] = (words[word] & ~(mask << offset)) | (Word(value) << offset);
+        if (offset + bits > BITS_PER_WORD) {
+            int shift = BITS_PER_WORD - offset;
+            words[word + 1] = (words[word + 1] & ~(mask >> shift)) | (Word(value) >> shift);
+        }
+    }
+};
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <vector>
 #include <set>
 #include <algorithm>
+#include <utility>
 #include "equivalence_relation.h"
 
 
@@ -77,6 +78,11 @@ class SCC {
     }
 
 
+    /*
+      Tarjan's depth-first search from vertex. The recursion is simulated
+      with an explicit stack of (vertex, index of the next successor)
+      frames, so that long paths do not overflow the call stack.
+    */
     template <class T>
 	static void dfs_equivalence(const std::vector<std::vector<Q> > &graph,
 				    int vertex, int & current_dfs_number,
@@ -86,37 +92,57 @@ class SCC {
 				    std::vector<int> & dfs_minima,
 				    std::vector<T > & final_sccs,
 				    std::vector<bool> * is_goal){
-	int vertex_dfs_number = current_dfs_number++;
-	dfs_numbers[vertex] = dfs_minima[vertex] = vertex_dfs_number;
-	stack_indices[vertex] = stack.size();
-	stack.push_back(vertex);
-
-	const std::vector<Q> &successors = graph[vertex];
-	for (size_t i = 0; i < successors.size(); i++) {
-	    int succ = get_successor (successors[i]);
-	    int succ_dfs_number = dfs_numbers[succ];
-	    if (succ_dfs_number == -1) {
-		dfs_equivalence(graph, succ, current_dfs_number, stack, stack_indices,
-				dfs_numbers, dfs_minima, final_sccs, is_goal);
-		dfs_minima[vertex] = std::min(dfs_minima[vertex], dfs_minima[succ]);
-	    } else if (succ_dfs_number < vertex_dfs_number && stack_indices[succ] != -1) {
-		dfs_minima[vertex] = std::min(dfs_minima[vertex], succ_dfs_number);
+	std::vector<std::pair<int, size_t>> call_stack;
+	auto visit = [&](int v) {
+	    dfs_numbers[v] = dfs_minima[v] = current_dfs_number++;
+	    stack_indices[v] = stack.size();
+	    stack.push_back(v);
+	    call_stack.emplace_back(v, 0);
+	};
+	visit(vertex);
+
+	while (!call_stack.empty()) {
+	    int v = call_stack.back().first;
+	    size_t &next_succ = call_stack.back().second;
+	    const std::vector<Q> &successors = graph[v];
+	    if (next_succ < successors.size()) {
+		int succ = get_successor (successors[next_succ]);
+		int succ_dfs_number = dfs_numbers[succ];
+		if (succ_dfs_number == -1) {
+		    // Continue with this successor when succ is finished.
+		    visit(succ);
+		    continue;
+		} else if (succ_dfs_number < dfs_numbers[v] && stack_indices[succ] != -1) {
+		    dfs_minima[v] = std::min(dfs_minima[v], succ_dfs_number);
+		}
+		if(is_goal && (*is_goal)[succ]){
+		    (*is_goal)[v] = true;
+		}
+		++next_succ;
+		continue;
 	    }
-	    if(is_goal && (*is_goal)[succ]){
-		(*is_goal)[vertex] = true;
-	    }
-	}
 
-	if (dfs_minima[vertex] == vertex_dfs_number) {
-	    int stack_index = stack_indices[vertex];
+	    if (dfs_minima[v] == dfs_numbers[v]) {
+		int stack_index = stack_indices[v];
+
+		final_sccs.push_back(T());
+		T & scc = final_sccs.back();
+		for (size_t i = stack_index; i < stack.size(); i++) {
+		    insert_in(scc, stack[i]);
+		    stack_indices[stack[i]] = -1;
+		}
+		stack.erase(stack.begin() + stack_index, stack.end());
+	    }
 
-	    final_sccs.push_back(T());
-	    T & scc = final_sccs.back();
-	    for (size_t i = stack_index; i < stack.size(); i++) {
-		insert_in(scc, stack[i]);
-		stack_indices[stack[i]] = -1;
+	    call_stack.pop_back();
+	    if (!call_stack.empty()) {
+		int parent = call_stack.back().first;
+		dfs_minima[parent] = std::min(dfs_minima[parent], dfs_minima[v]);
+		if(is_goal && (*is_goal)[v]){
+		    (*is_goal)[parent] = true;
+		}
+		++call_stack.back().second;
 	    }
-	    stack.erase(stack.begin() + stack_index, stack.end());
 	}
     }
 
@@ -155,7 +181,7 @@ public:
     std::vector<int> dfs_numbers(node_count, -1);
     std::vector<int> dfs_minima (node_count, -1);
     std::vector<int> stack_indices (node_count, -1);
-    std::vector<int> stack; // This is indexed by the level of recursion.
+    std::vector<int> stack; // Vertices of the SCCs not completed yet.
     stack.reserve(node_count);
     int current_dfs_number = 0;
 
@@ -0,0 +1,111 @@
+#ifndef ALGORITHMS_SPSC_QUEUE_H
+#define ALGORITHMS_SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace spsc_queue {
+/*
+  Unbounded lock-free queue for exactly one producer thread and exactly
+  one consumer thread. Every entry is a record of record_size values of
+  type T that is copied into the queue.
+
+  Records are stored in a linked list of blocks. The producer only
+  writes into the last block and publishes the number of records written
+  with release semantics, the consumer only reads published records from
+  the first block. Blocks are allocated by the producer and deleted by
+  the consumer once it has moved on to the next block, so memory usage
+  is proportional to the number of records in flight.
+*/
+template<typename T>
+class SPSCQueue {
+    struct Block {
+        std::vector<T> data;
+        std::atomic<int> num_written;
+        std::atomic<Block *> next;
+
+        explicit Block(int size)
+            : data(size),
+              num_written(0),
+              next(nullptr) {
+        }
+    };
+
+    const int record_size;
+    const int records_per_block;
+
+    // Only accessed by the consumer.
+    Block *head;
+    int num_read;
+
+    // Only accessed by the producer.
+    Block *tail;
+
+public:
+    explicit SPSCQueue(int record_size, int records_per_block = 1024)
+        : record_size(record_size),
+          records_per_block(records_per_block),
+          head(new Block(record_size * records_per_block)),
+          num_read(0),
+          tail(head) {
+        assert(record_size > 0 && records_per_block > 0);
+    }
+
+    ~SPSCQueue() {
+        while (head) {
+            Block *next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    int get_record_size() const {
+        return record_size;
+    }
+
+    // Producer side: append a copy of record[0..record_size).
+    void push(const T *record) {
+        int num_written = tail->num_written.load(std::memory_order_relaxed);
+        if (num_written == records_per_block) {
+            Block *block = new Block(record_size * records_per_block);
+            tail->next.store(block, std::memory_order_release);
+            tail = block;
+            num_written = 0;
+        }
+        std::copy(record, record + record_size,
+                  tail->data.begin() + num_written * record_size);
+        tail->num_written.store(num_written + 1, std::memory_order_release);
+    }
+
+    /*
+      Consumer side: return the oldest record or nullptr if no record is
+      available. The record stays valid until the next call to pop().
+    */
+    const T *front() {
+        if (num_read == records_per_block) {
+            Block *next = head->next.load(std::memory_order_acquire);
+            if (!next)
+                return nullptr;
+            delete head;
+            head = next;
+            num_read = 0;
+        }
+        if (num_read == head->num_written.load(std::memory_order_acquire))
+            return nullptr;
+        return head->data.data() + num_read * record_size;
+    }
+
+    // Consumer side: remove the record returned by the last call to front().
+    void pop() {
+        assert(num_read < head->num_written.load(std::memory_order_relaxed));
+        ++num_read;
+    }
+};
+}
+
+#endif
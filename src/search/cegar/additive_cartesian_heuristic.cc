@@ -43,7 +43,7 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -17,10 +17,8 @@ namespace dominance {
     bool applyPostSrc(const TransitionSystem &ts, int src,
                       std::function<bool(const Transition &t, LabelGroupID lg_id)> &&f) {
         for (LabelGroupID lg_id(0); lg_id < ts.num_label_groups(); ++lg_id) {
-            vector<Transition> trs = ts.get_transitions_for_group_id(lg_id);
-            auto tr = lower_bound(trs.begin(), trs.end(), Transition(src, 0));
-            auto end = upper_bound(trs.begin(), trs.end(), Transition(src, std::numeric_limits<int>::max()));
-            for (; tr != end; ++tr) {
+            auto trs = ts.get_transitions_for_group_id(lg_id).get_transitions_from(src);
+            for (auto tr = trs.first; tr != trs.second; ++tr) {
                 if (f(*tr, lg_id)) return true;
             }
         }
@@ -155,7 +153,7 @@ namespace dominance {
         for (LabelGroupID lg_id(0); lg_id < ts.num_label_groups(); ++lg_id) {
             std::fill(is_ok.begin(), is_ok.end(), false);
             std::fill(is_state_to_check.begin(), is_state_to_check.end(), false);
-            const std::vector<Transition> &trs = ts.get_transitions_for_group_id(lg_id);
+            const TransitionList &trs = ts.get_transitions_for_group_id(lg_id);
             std::vector<int> states_to_check;
 
             for (const auto &tr: trs) {
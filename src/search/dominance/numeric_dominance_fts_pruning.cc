@@ -88,12 +88,9 @@ namespace dominance {
             for (LabelGroupID lg1_id(0); lg1_id < ts.num_label_groups(); ++lg1_id) {
                 for (LabelGroupID lg2_id(0); lg2_id < ts.num_label_groups(); ++lg2_id) {
                     for (const Transition &tr1: ts.get_transitions_for_group_id(lg1_id)) {
-                        const vector<Transition> &trs2 = ts.get_transitions_for_group_id(lg2_id);
-                        auto tr2 = std::lower_bound(trs2.begin(), trs2.end(), Transition(tr1.src, 0));
-                        auto tr2_end = std::upper_bound(tr2, trs2.end(),
-                                                        Transition(tr1.src, std::numeric_limits<int>::max()));
+                        auto trs2 = ts.get_transitions_for_group_id(lg2_id).get_transitions_from(tr1.src);
 
-                        for (; tr2 != tr2_end; tr2++) {
+                        for (auto tr2 = trs2.first; tr2 != trs2.second; tr2++) {
                             assert(tr1.src == tr2->src);
                             for (int l1_id: ts.get_label_group(lg1_id)) {
                                 for (int l2_id: ts.get_label_group(lg2_id)) {
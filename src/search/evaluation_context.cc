@@ -83,7 +83,8 @@ EvaluationContext::get_preferred_operators(const task_representation::SearchTask
                                            const std::vector<OperatorID> & applicable_operators,
                                            Evaluator *heur,
                                            ordered_set::OrderedSet<OperatorID> & preferred_operators) {
-    get_result(heur).get_preferred_operators(heur->mapping, cache.get_state(), search_task, applicable_operators, preferred_operators);
+    get_result(heur).get_preferred_operators(heur->get_preferred_operators_index(search_task),
+                                             cache.get_state(), applicable_operators, preferred_operators);
 }
 
 
@@ -19,12 +19,12 @@ int EvaluationResult::get_h_value() const {
     return h_value;
 }
 
-void EvaluationResult::get_preferred_operators(const task_transformation::Mapping & mapping,
-                                               const GlobalState & state, const task_representation::SearchTask & search_task,
+void EvaluationResult::get_preferred_operators(PreferredOperatorsIndex & index,
+                                               const GlobalState & state,
                                                const std::vector<OperatorID> & applicable_operators,
                                                ordered_set::OrderedSet<OperatorID> & result_preferred_operators) const {
-    preferred_operators.get_preferred_operators(mapping, state, search_task,
-                                                applicable_operators, result_preferred_operators);
+    index.get_preferred_operators(preferred_operators, state,
+                                  applicable_operators, result_preferred_operators);
 }
 
 bool EvaluationResult::get_count_evaluation() const {
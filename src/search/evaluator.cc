@@ -2,6 +2,8 @@
 
 #include "plugin.h"
 
+#include "utils/memory.h"
+
 using namespace std;
 
 
@@ -9,6 +11,16 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+PreferredOperatorsIndex &Evaluator::get_preferred_operators_index(
+    const task_representation::SearchTask &search_task) {
+    if (!preferred_operators_index ||
+        &preferred_operators_index->get_search_task() != &search_task) {
+        preferred_operators_index = utils::make_unique_ptr<PreferredOperatorsIndex>(
+            search_task, mapping);
+    }
+    return *preferred_operators_index;
+}
+
 
 static PluginTypePlugin<Evaluator> _type_plugin(
     "Evaluator",
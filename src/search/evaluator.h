@@ -3,17 +3,27 @@
 
 #include "evaluation_result.h"
 
+#include <memory>
 #include <set>
 
 class EvaluationContext;
 class Heuristic;
 
 class Evaluator {
+    // Built on first use by get_preferred_operators_index.
+    std::unique_ptr<PreferredOperatorsIndex> preferred_operators_index;
 public:
     task_transformation::Mapping mapping;
     Evaluator() = default;
     virtual ~Evaluator() = default;
 
+    /*
+      Return the index used to compute the preferred operators of the
+      given search task from the results of this evaluator.
+    */
+    PreferredOperatorsIndex &get_preferred_operators_index(
+        const task_representation::SearchTask &search_task);
+
     /*
       dead_ends_are_reliable should return true if the evaluator is
       "safe", i.e., infinite estimates can be trusted.
@@ -26,12 +26,21 @@ int GlobalState::operator[](int var) const {
     return registry->get_state_value(buffer, var);
 }
 
+const int_packer::IntPacker &GlobalState::get_state_packer() const {
+    return registry->get_state_packer();
+}
+
 vector<int> GlobalState::get_values() const {
+    vector<int> values;
+    get_values(values);
+    return values;
+}
+
+void GlobalState::get_values(vector<int> &values) const {
     int num_variables = registry->get_num_variables();
-    vector<int> values(num_variables);
+    values.resize(num_variables);
     for (int var = 0; var < num_variables; ++var)
         values[var] = (*this)[var];
-    return values;
 }
 
 void GlobalState::dump_pddl() const {
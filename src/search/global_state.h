@@ -32,10 +32,6 @@ class GlobalState {
     GlobalState(
         const PackedStateBin *buffer, const StateRegistry &registry, StateID id);
 
-    const PackedStateBin *get_packed_buffer() const {
-        return buffer;
-    }
-
     const StateRegistry &get_registry() const {
         return *registry;
     }
@@ -48,7 +44,19 @@ public:
 
     int operator[](int var) const;
 
+    /*
+      Access to the packed state data for code that reads many variables in
+      a tight loop. Use the packer's VariableLocations to read the values.
+    */
+    const PackedStateBin *get_packed_buffer() const {
+        return buffer;
+    }
+
+    const int_packer::IntPacker &get_state_packer() const;
+
     std::vector<int> get_values() const;
+    // Store the values in the given vector, reusing its memory.
+    void get_values(std::vector<int> &values) const;
 
     void dump_pddl() const;
     void dump_fdr() const;
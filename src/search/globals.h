@@ -66,6 +66,8 @@ extern int_packer::IntPacker *g_state_packer;
 /* extern AxiomEvaluator *g_axiom_evaluator; */
 /* extern successor_generator::SuccessorGenerator *g_successor_generator; */
 extern std::string g_plan_filename;
+// Directory for cached task transformations (empty: no caching)
+extern std::string g_transform_cache_dir;
 extern int g_num_previously_generated_plans;
 extern bool g_is_part_of_anytime_portfolio;
 
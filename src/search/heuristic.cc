@@ -11,6 +11,8 @@
 #include "task_transformation/task_transformation.h"
 #include "task_transformation/state_mapping.h"
 
+#include "utils/memory.h"
+
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -31,6 +33,7 @@ Heuristic::Heuristic(const Options &opts)
     task = transformation.first;
     mapping = transformation.second;
     search_task = task->get_search_task(true);
+    state_buffer = utils::make_unique_ptr<State>(*task, vector<int>());
 
     cout << "Heuristic task: " <<  *task << endl;
 }
@@ -49,12 +52,13 @@ bool Heuristic::notify_state_transition(
     return false;
 }
 
-State Heuristic::convert_global_state(const GlobalState &global_state) const {
+const State &Heuristic::convert_global_state(const GlobalState &global_state) const {
     if (mapping.state_mapping) {
-        return State(*task, mapping.state_mapping->convert_state(global_state));
-    }else {
-        return State(*task, global_state.get_values());
+        mapping.state_mapping->convert_state(global_state, state_buffer->values);
+    } else {
+        global_state.get_values(state_buffer->values);
     }
+    return *state_buffer;
 }
 
 void Heuristic::add_options_to_parser(OptionParser &parser) {
@@ -55,6 +55,9 @@ protected:
     std::shared_ptr<task_representation::FTSTask> task;
     std::shared_ptr<task_representation::SearchTask> search_task;
 
+    // Reused by convert_global_state.
+    std::unique_ptr<task_representation::State> state_buffer;
+
     OperatorCost cost_type;
 
     enum {DEAD_END = -1, NO_VALUE = -2};
@@ -70,7 +73,16 @@ protected:
     void set_preferred(int label, const task_representation::FactPair & fact);
     
 
-    task_representation::State convert_global_state(const GlobalState &global_state) const;
+    /*
+      Return the state of the heuristic task corresponding to the given
+      search state. The result is stored in a buffer owned by the heuristic,
+      so converting states does not allocate memory once the buffer has
+      grown to its final size. Computing the heuristic value and reporting
+      preferred operators may still allocate. The reference is only valid
+      until the next call of this function.
+    */
+    const task_representation::State &convert_global_state(
+        const GlobalState &global_state) const;
 
 public:
     explicit Heuristic(const options::Options &options);
@@ -83,6 +95,15 @@ public:
         const GlobalState &parent_state, const OperatorID op,
         const GlobalState &state);
 
+    /*
+      Return true if the heuristic value of a state depends on the path on
+      which it was reached, i.e., if the heuristic relies on
+      notify_initial_state and notify_state_transition.
+    */
+    virtual bool is_path_dependent() const {
+        return false;
+    }
+
     virtual void get_involved_heuristics(std::set<Heuristic *> &hset) override {
         hset.insert(this);
     }
@@ -146,7 +146,7 @@ int AdditiveHeuristic::compute_heuristic(const State &state) {
 }
 
 int AdditiveHeuristic::compute_heuristic(const GlobalState &global_state) {
-    auto state = convert_global_state(global_state);
+    const auto &state = convert_global_state(global_state);
     if (state.is_dead_end()) {
         return DEAD_END;
     }
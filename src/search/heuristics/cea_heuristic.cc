@@ -394,7 +394,7 @@ void ContextEnhancedAdditiveHeuristic::mark_helpful_transitions(
 }
 
 int ContextEnhancedAdditiveHeuristic::compute_heuristic(const GlobalState &g_state) {
-    auto state = convert_global_state(global_state);
+    const auto &state = convert_global_state(global_state);
     if (state.is_dead_end()) {
         return DEAD_END;
     }
@@ -36,7 +36,7 @@ void FFHeuristic::relaxed_plan_extraction(Proposition *goal) {
 }
 
     int FFHeuristic::compute_heuristic(const GlobalState &global_state) {
-        auto state = convert_global_state(global_state);
+        const auto &state = convert_global_state(global_state);
         if (state.is_dead_end()) {
             return DEAD_END;
         }
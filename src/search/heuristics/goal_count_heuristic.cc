@@ -16,7 +16,7 @@ GoalCountHeuristic::~GoalCountHeuristic() {
 }
 
 int GoalCountHeuristic::compute_heuristic(const GlobalState &global_state) {
-    auto state = convert_global_state(global_state);
+    const auto &state = convert_global_state(global_state);
     if (state.is_dead_end()) {
         return DEAD_END;
     }
@@ -74,6 +74,10 @@ public:
         }
         return false;
     }
+
+    virtual bool is_path_dependent() const override {
+        return true;
+    }
 };
 
 class FFSlaveHeuristic : public Heuristic {
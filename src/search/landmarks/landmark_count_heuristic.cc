@@ -129,7 +129,7 @@ int LandmarkCountHeuristic::get_heuristic_value(const GlobalState &global_state)
 }
 
 int LandmarkCountHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
 
     if (task_properties::is_goal_state(task_proxy, state))
         return 0;
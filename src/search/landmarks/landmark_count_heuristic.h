@@ -56,6 +56,9 @@ public:
     virtual bool notify_state_transition(const GlobalState &parent_state,
                                          const GlobalOperator &op,
                                          const GlobalState &state) override;
+    virtual bool is_path_dependent() const override {
+        return true;
+    }
     virtual bool dead_ends_are_reliable() const override;
 };
 }
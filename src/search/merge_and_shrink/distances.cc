@@ -5,8 +5,12 @@
 
 #include "../algorithms/priority_queues.h"
 
+#include "../utils/collections.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
 #include <cassert>
-#include <deque>
+#include <memory>
 
 using namespace std;
 
@@ -46,52 +50,149 @@ bool Distances::is_unit_cost() const {
     return true;
 }
 
-static void breadth_first_search(
-    const vector<vector<int>> &graph, deque<int> &queue,
-    vector<int> &distances) {
-    while (!queue.empty()) {
-        int state = queue.front();
-        queue.pop_front();
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            int successor = graph[state][i];
-            if (distances[successor] > distances[state] + 1) {
-                distances[successor] = distances[state] + 1;
-                queue.push_back(successor);
-            }
-        }
+namespace {
+/*
+  Graph in compressed sparse row format. The arcs of each state are sorted
+  by cost and split into runs of arcs with equal cost, so that arc costs
+  take no space per arc. The runs of state v are state_first_run[v] to
+  state_first_run[v + 1] - 1, and the arcs of run r are run_first_arc[r]
+  to run_first_arc[r + 1] - 1 with cost run_cost[r]. As the runs of a
+  state are consecutive, its arcs are consecutive as well.
+*/
+struct Graph {
+    vector<int> state_first_run;
+    vector<int> run_first_arc;
+    vector<int> run_cost;
+    vector<int> arc_target;
+
+    int get_first_arc(int state) const {
+        return run_first_arc[state_first_run[state]];
     }
+};
+
+/*
+  Queues of the distance computation. Distances are recomputed after every
+  merge, shrink and label reduction, so we keep the queues across calls
+  instead of reallocating them every time. The graph is built anew for
+  each call because keeping its arcs would add to the peak memory of the
+  merge steps in between. Every thread has its own queues.
+*/
+struct Workspace {
+    vector<int> bfs_queue;
+    unique_ptr<priority_queues::AdaptiveQueue<int>> dijkstra_queue;
+};
+
+thread_local Workspace workspace;
 }
 
-void Distances::compute_init_distances_unit_cost() {
-    vector<vector<int>> forward_graph(get_num_states());
+// Build the forward or backward graph of the transition system.
+static void build_graph(
+    const TransitionSystem &transition_system, bool backward, Graph &graph) {
+    int num_states = transition_system.get_size();
+
+    // Label groups by increasing cost
+    vector<pair<int, const vector<Transition> *>> groups;
     for (const GroupAndTransitions &gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(transition.target);
+        if (!gat.transitions.empty()) {
+            groups.emplace_back(gat.label_group.get_cost(), &gat.transitions);
+        }
+    }
+    stable_sort(groups.begin(), groups.end(),
+                [](const pair<int, const vector<Transition> *> &lhs,
+                   const pair<int, const vector<Transition> *> &rhs) {
+                    return lhs.first < rhs.first;
+                });
+
+    // Count the runs and arcs of each state.
+    vector<int> &state_first_run = graph.state_first_run;
+    state_first_run.assign(num_states + 1, 0);
+    vector<int> next_arc(num_states + 1, 0);
+    vector<int> last_cost(num_states, -1);
+    for (const auto &group : groups) {
+        int cost = group.first;
+        for (const Transition &transition : *group.second) {
+            int from = backward ? transition.target : transition.src;
+            if (last_cost[from] != cost) {
+                last_cost[from] = cost;
+                ++state_first_run[from + 1];
+            }
+            ++next_arc[from + 1];
         }
     }
+    for (int state = 0; state < num_states; ++state) {
+        state_first_run[state + 1] += state_first_run[state];
+        next_arc[state + 1] += next_arc[state];
+    }
+    int num_runs = state_first_run[num_states];
+    int num_arcs = next_arc[num_states];
 
-    deque<int> queue;
-    // TODO: This is an oddly inefficient initialization! Fix it.
-    for (int state = 0; state < get_num_states(); ++state) {
-        if (state == transition_system.get_init_state()) {
-            init_distances[state] = 0;
-            queue.push_back(state);
+    /*
+      Fill in the runs and arcs. All arcs of a cost come before the arcs
+      of the next higher cost, so the arcs of each run are consecutive.
+    */
+    graph.run_first_arc.resize(num_runs + 1);
+    graph.run_first_arc[num_runs] = num_arcs;
+    graph.run_cost.resize(num_runs);
+    graph.arc_target.resize(num_arcs);
+    vector<int> next_run(state_first_run.begin(), state_first_run.end() - 1);
+    fill(last_cost.begin(), last_cost.end(), -1);
+    for (const auto &group : groups) {
+        int cost = group.first;
+        for (const Transition &transition : *group.second) {
+            int from = backward ? transition.target : transition.src;
+            if (last_cost[from] != cost) {
+                last_cost[from] = cost;
+                int run = next_run[from]++;
+                graph.run_first_arc[run] = next_arc[from];
+                graph.run_cost[run] = cost;
+            }
+            graph.arc_target[next_arc[from]++] =
+                backward ? transition.src : transition.target;
         }
     }
-    breadth_first_search(forward_graph, queue, init_distances);
 }
 
-void Distances::compute_goal_distances_unit_cost() {
-    vector<vector<int>> backward_graph(get_num_states());
-    for (const GroupAndTransitions &gat : transition_system) {
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(transition.src);
+/*
+  Every state enters the queue at most once because the first distance
+  assigned to a state is its final one.
+*/
+static void breadth_first_search(
+    const Graph &graph, vector<int> &queue, vector<int> &distances) {
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        int successor_distance = distances[state] + 1;
+        int end = graph.get_first_arc(state + 1);
+        for (int arc = graph.get_first_arc(state); arc < end; ++arc) {
+            int successor = graph.arc_target[arc];
+            if (distances[successor] > successor_distance) {
+                distances[successor] = successor_distance;
+                queue.push_back(successor);
+            }
         }
     }
+}
 
-    deque<int> queue;
+void Distances::compute_init_distances_unit_cost() {
+    Graph forward_graph;
+    build_graph(transition_system, false, forward_graph);
+
+    vector<int> &queue = workspace.bfs_queue;
+    queue.clear();
+    int init_state = transition_system.get_init_state();
+    // The initial state may have been pruned.
+    if (init_state != PRUNED_STATE) {
+        init_distances[init_state] = 0;
+        queue.push_back(init_state);
+    }
+    breadth_first_search(forward_graph, queue, init_distances);
+}
+
+void Distances::compute_goal_distances_unit_cost() {
+    Graph backward_graph;
+    build_graph(transition_system, true, backward_graph);
+
+    vector<int> &queue = workspace.bfs_queue;
+    queue.clear();
     for (int state = 0; state < get_num_states(); ++state) {
         if (transition_system.is_goal_state(state)) {
             goal_distances[state] = 0;
@@ -101,8 +202,17 @@ void Distances::compute_goal_distances_unit_cost() {
     breadth_first_search(backward_graph, queue, goal_distances);
 }
 
+static priority_queues::AdaptiveQueue<int> &get_dijkstra_queue() {
+    if (!workspace.dijkstra_queue) {
+        workspace.dijkstra_queue =
+            utils::make_unique_ptr<priority_queues::AdaptiveQueue<int>>();
+    }
+    workspace.dijkstra_queue->clear();
+    return *workspace.dijkstra_queue;
+}
+
 static void dijkstra_search(
-    const vector<vector<pair<int, int>>> &graph,
+    const Graph &graph,
     priority_queues::AdaptiveQueue<int> &queue,
     vector<int> &distances) {
     while (!queue.empty()) {
@@ -113,59 +223,40 @@ static void dijkstra_search(
         assert(state_distance <= distance);
         if (state_distance < distance)
             continue;
-        for (size_t i = 0; i < graph[state].size(); ++i) {
-            const pair<int, int> &transition = graph[state][i];
-            int successor = transition.first;
-            int cost = transition.second;
-            int successor_cost = state_distance + cost;
-            if (distances[successor] > successor_cost) {
-                distances[successor] = successor_cost;
-                queue.push(successor_cost, successor);
+        for (int run = graph.state_first_run[state];
+             run < graph.state_first_run[state + 1]; ++run) {
+            int successor_cost = state_distance + graph.run_cost[run];
+            for (int arc = graph.run_first_arc[run];
+                 arc < graph.run_first_arc[run + 1]; ++arc) {
+                int successor = graph.arc_target[arc];
+                if (distances[successor] > successor_cost) {
+                    distances[successor] = successor_cost;
+                    queue.push(successor_cost, successor);
+                }
             }
         }
     }
 }
 
 void Distances::compute_init_distances_general_cost() {
-    vector<vector<pair<int, int>>> forward_graph(get_num_states());
-    for (const GroupAndTransitions &gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            forward_graph[transition.src].push_back(
-                make_pair(transition.target, cost));
-        }
-    }
-
-    // TODO: Reuse the same queue for multiple computations to save speed?
-    //       Also see compute_goal_distances_general_cost.
-    priority_queues::AdaptiveQueue<int> queue;
-    // TODO: This is an oddly inefficient initialization! Fix it.
-    for (int state = 0; state < get_num_states(); ++state) {
-        if (state == transition_system.get_init_state()) {
-            init_distances[state] = 0;
-            queue.push(0, state);
-        }
+    Graph forward_graph;
+    build_graph(transition_system, false, forward_graph);
+
+    priority_queues::AdaptiveQueue<int> &queue = get_dijkstra_queue();
+    int init_state = transition_system.get_init_state();
+    // The initial state may have been pruned.
+    if (init_state != PRUNED_STATE) {
+        init_distances[init_state] = 0;
+        queue.push(0, init_state);
     }
     dijkstra_search(forward_graph, queue, init_distances);
 }
 
 void Distances::compute_goal_distances_general_cost() {
-    vector<vector<pair<int, int>>> backward_graph(get_num_states());
-    for (const GroupAndTransitions &gat : transition_system) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        int cost = label_group.get_cost();
-        for (const Transition &transition : transitions) {
-            backward_graph[transition.target].push_back(
-                make_pair(transition.src, cost));
-        }
-    }
+    Graph backward_graph;
+    build_graph(transition_system, true, backward_graph);
 
-    // TODO: Reuse the same queue for multiple computations to save speed?
-    //       Also see compute_init_distances_general_cost.
-    priority_queues::AdaptiveQueue<int> queue;
+    priority_queues::AdaptiveQueue<int> &queue = get_dijkstra_queue();
     for (int state = 0; state < get_num_states(); ++state) {
         if (transition_system.is_goal_state(state)) {
             goal_distances[state] = 0;
@@ -175,6 +266,11 @@ void Distances::compute_goal_distances_general_cost() {
     dijkstra_search(backward_graph, queue, goal_distances);
 }
 
+void Distances::release_workspace_memory() {
+    utils::release_vector_memory(workspace.bfs_queue);
+    workspace.dijkstra_queue = nullptr;
+}
+
 void Distances::compute_distances(
     bool compute_init_distances,
     bool compute_goal_distances,
@@ -75,6 +75,12 @@ public:
         return goal_distances[state];
     }
 
+    /*
+      Free the memory that the distance computation of the calling thread
+      keeps for later calls.
+    */
+    static void release_workspace_memory();
+
     void dump() const;
     void statistics() const;
 };
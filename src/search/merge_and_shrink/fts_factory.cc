@@ -81,7 +81,7 @@ unique_ptr<TransitionSystem> FTSFactory::copy_ts(
     for (const task_representation::GroupAndTransitions &gat : ts) {
         const task_representation::LabelGroup &label_group = gat.label_group;
         int group_id = label_equivalence_relation->add_label_group(label_group.begin(), label_group.end());
-        const vector<task_representation::Transition> &transitions = gat.transitions;
+        const task_representation::TransitionList &transitions = gat.transitions;
         vector<Transition> transitions_copy;
         transitions_copy.reserve(transitions.size());
         for (const task_representation::Transition &transition : transitions) {
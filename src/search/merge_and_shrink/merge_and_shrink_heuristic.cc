@@ -7,12 +7,14 @@
 #include "transition_system.h"
 #include "types.h"
 
+#include "../global_state.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../task_representation/state.h"
 
 #include "../utils/markup.h"
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -24,7 +26,8 @@ using utils::ExitCode;
 
 namespace merge_and_shrink {
 MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      state_packer(nullptr) {
     Verbosity verbosity = static_cast<Verbosity>(opts.get_enum("verbosity"));
 
     cout << "Initializing merge-and-shrink heuristic..." << endl;
@@ -68,7 +71,8 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     cout << "Final transition system size: "
          << fts.get_transition_system(ts_index).get_size() << endl;
 
-    mas_representation = move(final_entry.first);
+    unique_ptr<MergeAndShrinkRepresentation> final_representation =
+        move(final_entry.first);
     unique_ptr<Distances> final_distances = move(final_entry.second);
     if (!final_distances->are_goal_distances_computed()) {
         const bool compute_init = false;
@@ -77,17 +81,50 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
             compute_init, compute_goal, verbosity);
     }
     assert(final_distances->are_goal_distances_computed());
-    mas_representation->set_distances(*final_distances);
+    Distances::release_workspace_memory();
+    final_representation->set_distances(*final_distances);
+    mas_representation = utils::make_unique_ptr<FlatMergeAndShrinkRepresentation>(
+        *final_representation);
+    cout << "Final representation: " << mas_representation->get_num_nodes()
+         << " nodes, " << mas_representation->get_num_table_entries()
+         << " lookup table entries" << endl;
     cout << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
-int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state) {
-    auto state = convert_global_state(global_state);
-    if (state.is_dead_end()) {
-        return DEAD_END;
+MergeAndShrinkHeuristic::~MergeAndShrinkHeuristic() {
+}
+
+void MergeAndShrinkHeuristic::compute_variable_locations(
+    const int_packer::IntPacker &packer) {
+    state_packer = &packer;
+    int num_variables = task->get_size();
+    variable_locations.clear();
+    variable_locations.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        variable_locations.push_back(packer.get_variable_location(var));
     }
+}
 
-    int cost = mas_representation->get_value(state);
+int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state) {
+    int cost;
+    if (mapping.state_mapping) {
+        const auto &state = convert_global_state(global_state);
+        if (state.is_dead_end()) {
+            return DEAD_END;
+        }
+        cost = mas_representation->get_value(
+            [&state](int var) {return state[var];});
+    } else {
+        const int_packer::IntPacker &packer = global_state.get_state_packer();
+        if (&packer != state_packer) {
+            compute_variable_locations(packer);
+        }
+        const PackedStateBin *buffer = global_state.get_packed_buffer();
+        cost = mas_representation->get_value(
+            [this, buffer](int var) {
+                return int_packer::IntPacker::get(buffer, variable_locations[var]);
+            });
+    }
     if (cost == PRUNED_STATE || cost == INF) {
         // If state is unreachable or irrelevant, we encountered a dead end.
         return DEAD_END;
@@ -3,18 +3,32 @@
 
 #include "../heuristic.h"
 
+#include "../algorithms/int_packer.h"
+
 #include <memory>
+#include <vector>
 
 namespace merge_and_shrink {
-class MergeAndShrinkRepresentation;
+class FlatMergeAndShrinkRepresentation;
 
 class MergeAndShrinkHeuristic : public Heuristic {
     // The final merge-and-shrink representation, storing goal distances.
-    std::unique_ptr<MergeAndShrinkRepresentation> mas_representation;
+    std::unique_ptr<FlatMergeAndShrinkRepresentation> mas_representation;
+
+    /*
+      Locations of the variables in the packed states of the registry with
+      the given state packer. Only used if the heuristic task is the task
+      of the search, i.e. there is no state mapping.
+    */
+    const int_packer::IntPacker *state_packer;
+    std::vector<int_packer::IntPacker::VariableLocation> variable_locations;
+
+    void compute_variable_locations(const int_packer::IntPacker &packer);
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
 public:
     explicit MergeAndShrinkHeuristic(const options::Options &opts);
+    virtual ~MergeAndShrinkHeuristic() override;
 };
 }
 
@@ -61,6 +61,11 @@ int MergeAndShrinkRepresentationLeaf::get_value(const task_representation::State
     return lookup_table[value];
 }
 
+int MergeAndShrinkRepresentationLeaf::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    return flat.add_leaf(var_id, lookup_table);
+}
+
 void MergeAndShrinkRepresentationLeaf::dump() const {
     cout << "lookup table: ";
     for (const auto &value : lookup_table) {
@@ -123,6 +128,13 @@ int MergeAndShrinkRepresentationMerge::get_value(
     return lookup_table[state1][state2];
 }
 
+int MergeAndShrinkRepresentationMerge::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    int left = left_child->flatten(flat);
+    int right = right_child->flatten(flat);
+    return flat.add_merge(left, right, lookup_table);
+}
+
 void MergeAndShrinkRepresentationMerge::dump() const {
     cout << "lookup table: ";
     for (const auto &row : lookup_table) {
@@ -137,4 +149,40 @@ void MergeAndShrinkRepresentationMerge::dump() const {
     cout << "dump right child:" << endl;
     right_child->dump();
 }
+
+
+FlatMergeAndShrinkRepresentation::FlatMergeAndShrinkRepresentation(
+    const MergeAndShrinkRepresentation &representation) {
+    representation.flatten(*this);
+    node_values.resize(nodes.size());
+}
+
+int FlatMergeAndShrinkRepresentation::add_leaf(
+    int var, const vector<int> &lookup_table) {
+    Node node;
+    node.left = var;
+    node.right = -1;
+    node.right_domain_size = 0;
+    node.table_offset = tables.size();
+    tables.insert(tables.end(), lookup_table.begin(), lookup_table.end());
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+int FlatMergeAndShrinkRepresentation::add_merge(
+    int left, int right, const vector<vector<int>> &lookup_table) {
+    assert(left < static_cast<int>(nodes.size()));
+    assert(right < static_cast<int>(nodes.size()));
+    Node node;
+    node.left = left;
+    node.right = right;
+    node.right_domain_size = lookup_table.empty() ? 0 : lookup_table[0].size();
+    node.table_offset = tables.size();
+    for (const vector<int> &row : lookup_table) {
+        assert(static_cast<int>(row.size()) == node.right_domain_size);
+        tables.insert(tables.end(), row.begin(), row.end());
+    }
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
 }
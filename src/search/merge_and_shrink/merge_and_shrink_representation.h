@@ -1,6 +1,8 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include "types.h"
+
 #include <memory>
 #include <vector>
 
@@ -10,6 +12,8 @@ class State;
 
 namespace merge_and_shrink {
 class Distances;
+class FlatMergeAndShrinkRepresentation;
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -27,6 +31,11 @@ public:
     virtual int get_value(const task_representation::State &state) const = 0;
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) = 0;
+    /*
+      Append the nodes of this representation to flat in post-order and
+      return the index of this node.
+    */
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const = 0;
     virtual void dump() const = 0;
 };
 
@@ -43,6 +52,7 @@ public:
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const task_representation::State &state) const override;
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const override;
     virtual void dump() const override;
 };
 
@@ -61,8 +71,85 @@ public:
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const task_representation::State &state) const override;
+    virtual int flatten(FlatMergeAndShrinkRepresentation &flat) const override;
     virtual void dump() const override;
 };
+
+
+/*
+  Read-only copy of a merge-and-shrink representation for fast evaluation.
+  The nodes of the representation are stored in post-order in a single
+  vector and all lookup tables are stored consecutively (merge tables in
+  row-major order) in another vector, so that computing the value of a
+  state is a loop over the nodes without virtual calls or allocations.
+
+  get_value takes a function that maps a variable to its value in the
+  state to evaluate, so that the values can be read directly from a packed
+  state.
+*/
+class FlatMergeAndShrinkRepresentation {
+    friend class MergeAndShrinkRepresentationLeaf;
+    friend class MergeAndShrinkRepresentationMerge;
+
+    /*
+      For merges, left and right are the indices of the children, which
+      precede the node. For leaves, left is the variable and right is -1.
+    */
+    struct Node {
+        int left;
+        int right;
+        int right_domain_size;
+        int table_offset;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> tables;
+    // Values of all nodes for the state currently being evaluated.
+    mutable std::vector<int> node_values;
+
+    int add_leaf(int var, const std::vector<int> &lookup_table);
+    int add_merge(int left, int right,
+                  const std::vector<std::vector<int>> &lookup_table);
+public:
+    explicit FlatMergeAndShrinkRepresentation(
+        const MergeAndShrinkRepresentation &representation);
+
+    template<typename StateValues>
+    int get_value(const StateValues &state_values) const;
+
+    std::size_t get_num_nodes() const {
+        return nodes.size();
+    }
+
+    std::size_t get_num_table_entries() const {
+        return tables.size();
+    }
+};
+
+template<typename StateValues>
+int FlatMergeAndShrinkRepresentation::get_value(
+    const StateValues &state_values) const {
+    int num_nodes = nodes.size();
+    for (int i = 0; i < num_nodes; ++i) {
+        const Node &node = nodes[i];
+        int value;
+        if (node.right == -1) {
+            value = tables[node.table_offset + state_values(node.left)];
+        } else {
+            int left_value = node_values[node.left];
+            int right_value = node_values[node.right];
+            if (left_value == PRUNED_STATE || right_value == PRUNED_STATE) {
+                value = PRUNED_STATE;
+            } else {
+                value = tables[node.table_offset +
+                               left_value * node.right_domain_size +
+                               right_value];
+            }
+        }
+        node_values[i] = value;
+    }
+    return node_values[num_nodes - 1];
+}
 }
 
 #endif
@@ -1,6 +1,5 @@
 #include "merge_scoring_function_miasm.h"
 
-#include "distances.h"
 #include "factored_transition_system.h"
 #include "merge_and_shrink_algorithm.h"
 #include "shrink_strategy.h"
@@ -11,9 +10,12 @@
 #include "../options/options.h"
 #include "../options/plugin.h"
 
+#include "../task_transformation/virtual_product.h"
+
 #include "../utils/markup.h"
 
 using namespace std;
+using task_transformation::VirtualProduct;
 
 namespace merge_and_shrink {
 MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
@@ -32,7 +34,7 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
     for (pair<int, int> merge_candidate : merge_candidates) {
         int index1 = merge_candidate.first;
         int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        unique_ptr<VirtualProduct> product = shrink_before_merge_externally(
             fts,
             index1,
             index2,
@@ -41,17 +43,17 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
             max_states_before_merge,
             shrink_threshold_before_merge);
 
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        const Verbosity verbosity = Verbosity::SILENT;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
+        /*
+          Compute distances for the product and count the alive states.
+          Only reachability matters here, so we ignore label costs.
+        */
+        vector<int> init_distances = product->compute_init_distances();
+        vector<int> goal_distances = product->compute_goal_distances();
         int num_states = product->get_size();
         int alive_states_count = 0;
         for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
+            if (init_distances[state] != task_transformation::INF &&
+                goal_distances[state] != task_transformation::INF) {
                 ++alive_states_count;
             }
         }
@@ -2,15 +2,19 @@
 
 #include "distances.h"
 #include "factored_transition_system.h"
+#include "label_equivalence_relation.h"
 #include "shrink_strategy.h"
 #include "transition_system.h"
 #include "utils.h"
 
+#include "../task_transformation/virtual_product.h"
+
 #include "../utils/memory.h"
 
 #include <algorithm>
 
 using namespace std;
+using task_transformation::VirtualProduct;
 
 namespace merge_and_shrink {
 /*
@@ -53,7 +57,7 @@ unique_ptr<TransitionSystem> copy_and_shrink_ts(
     }
 }
 
-unique_ptr<TransitionSystem> shrink_before_merge_externally(
+unique_ptr<VirtualProduct> shrink_before_merge_externally(
     const FactoredTransitionSystem &fts,
     int index1,
     int index2,
@@ -104,12 +108,11 @@ unique_ptr<TransitionSystem> shrink_before_merge_externally(
 
     /*
       Return the product, using either the original transition systems or
-      the copied and shrunk ones.
+      the copied and shrunk ones. The product does not reference them, so
+      the copies can be released right away.
     */
-    return TransitionSystem::merge(
-        fts.get_labels(),
+    return utils::make_unique_ptr<VirtualProduct>(
         (ts1 ? *ts1 : original_ts1),
-        (ts2 ? *ts2 : original_ts2),
-        verbosity);
+        (ts2 ? *ts2 : original_ts2));
 }
 }
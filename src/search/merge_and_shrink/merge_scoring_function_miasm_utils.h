@@ -3,17 +3,20 @@
 
 #include <memory>
 
+namespace task_transformation {
+class VirtualProduct;
+}
+
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
 class ShrinkStrategy;
-class TransitionSystem;
 
 /*
   Copy the two transition systems at the given indices, possibly shrink them
-  according to the same rules as merge-and-shrink does, and return their
-  product.
+  according to the same rules as merge-and-shrink does, and return a lazy
+  view of their product.
 */
-extern std::unique_ptr<TransitionSystem> shrink_before_merge_externally(
+extern std::unique_ptr<task_transformation::VirtualProduct> shrink_before_merge_externally(
     const FactoredTransitionSystem &fts,
     int index1,
     int index2,
@@ -0,0 +1,249 @@
+#include "bucket_open_list.h"
+
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/collections.h"
+#include "../utils/memory.h"
+
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    /*
+      Entries are removed from the front (FIFO) by advancing next or from
+      the back (LIFO). The consumed prefix of a FIFO bucket is only erased
+      once it makes up half of the bucket, which keeps removal amortized
+      constant.
+    */
+    struct Bucket {
+        vector<Entry> entries;
+        size_t next;
+
+        Bucket() : next(0) {
+        }
+
+        bool empty() const {
+            return next == entries.size();
+        }
+    };
+
+    // All buckets with the same value of the first evaluator.
+    struct Layer {
+        vector<Bucket> buckets;
+        int num_entries;
+        int min_index;
+
+        Layer() : num_entries(0), min_index(0) {
+        }
+    };
+
+    vector<Layer> layers;
+    int min_layer;
+    int size;
+
+    vector<Evaluator *> evaluators;
+    TieBreaking tie_breaking;
+
+    Entry pop(Bucket &bucket);
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min(vector<int> *key = nullptr) override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_involved_heuristics(set<Heuristic *> &hset) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      min_layer(0),
+      size(0),
+      evaluators(opts.get_list<Evaluator *>("evals")),
+      tie_breaking(static_cast<TieBreaking>(opts.get_enum("tie_breaking"))) {
+    assert(evaluators.size() == 1 || evaluators.size() == 2);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int layer_index = eval_context.get_heuristic_value(evaluators[0]);
+    int bucket_index = 0;
+    if (evaluators.size() == 2) {
+        bucket_index = eval_context.get_heuristic_value(evaluators[1]);
+    }
+    assert(layer_index >= 0 && bucket_index >= 0);
+
+    if (layer_index >= static_cast<int>(layers.size())) {
+        layers.resize(layer_index + 1);
+    }
+    Layer &layer = layers[layer_index];
+    if (bucket_index >= static_cast<int>(layer.buckets.size())) {
+        layer.buckets.resize(bucket_index + 1);
+    }
+    layer.buckets[bucket_index].entries.push_back(entry);
+
+    if (layer.num_entries == 0 || bucket_index < layer.min_index) {
+        layer.min_index = bucket_index;
+    }
+    ++layer.num_entries;
+    if (size == 0 || layer_index < min_layer) {
+        min_layer = layer_index;
+    }
+    ++size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::pop(Bucket &bucket) {
+    assert(!bucket.empty());
+    if (tie_breaking == TieBreaking::LIFO) {
+        Entry result = bucket.entries.back();
+        bucket.entries.pop_back();
+        return result;
+    }
+    Entry result = bucket.entries[bucket.next++];
+    if (bucket.empty()) {
+        bucket.entries.clear();
+        bucket.next = 0;
+    } else if (bucket.next >= 1024 && 2 * bucket.next >= bucket.entries.size()) {
+        bucket.entries.erase(bucket.entries.begin(),
+                             bucket.entries.begin() + bucket.next);
+        bucket.next = 0;
+    }
+    return result;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min(vector<int> *key) {
+    assert(size > 0);
+    while (layers[min_layer].num_entries == 0) {
+        /*
+          With consistent heuristics, no further entries are inserted into
+          layers below the minimum, so we free their memory.
+        */
+        utils::release_vector_memory(layers[min_layer].buckets);
+        ++min_layer;
+    }
+    Layer &layer = layers[min_layer];
+    while (layer.buckets[layer.min_index].empty()) {
+        ++layer.min_index;
+    }
+    if (key) {
+        assert(key->empty());
+        key->push_back(min_layer);
+        if (evaluators.size() == 2) {
+            key->push_back(layer.min_index);
+        }
+    }
+    --layer.num_entries;
+    --size;
+    return pop(layer.buckets[layer.min_index]);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    layers.clear();
+    min_layer = 0;
+    size = 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_involved_heuristics(
+    set<Heuristic *> &hset) {
+    for (Evaluator *evaluator : evaluators)
+        evaluator->get_involved_heuristics(hset);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    for (Evaluator *evaluator : evaluators)
+        if (eval_context.is_heuristic_infinite(evaluator))
+            return true;
+    return false;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (Evaluator *evaluator : evaluators)
+        if (eval_context.is_heuristic_infinite(evaluator) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Bucket open list",
+        "Selects the entry with minimal value of the first evaluator, "
+        "breaking ties by the second evaluator (if given) and then "
+        "according to tie_breaking. Entries are stored in an array of buckets "
+        "indexed by evaluator values, so this open list is only suited for "
+        "evaluators with small non-negative values. States for which some "
+        "evaluator is infinite are considered dead ends.");
+    parser.add_list_option<Evaluator *>("evals", "one or two evaluators");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+    vector<string> tie_breaking;
+    vector<string> tie_breaking_doc;
+    tie_breaking.push_back("FIFO");
+    tie_breaking_doc.push_back("first in, first out");
+    tie_breaking.push_back("LIFO");
+    tie_breaking_doc.push_back("last in, first out");
+    parser.add_enum_option(
+        "tie_breaking",
+        tie_breaking,
+        "order of entries with the same evaluator values",
+        "FIFO",
+        tie_breaking_doc);
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<Evaluator *>("evals");
+    if (opts.get_list<Evaluator *>("evals").size() > 2) {
+        parser.error("bucket open list supports at most two evaluators");
+    }
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketOpenListFactory>(opts);
+}
+
+static PluginShared<OpenListFactory> _plugin("bucket", _parse);
+}
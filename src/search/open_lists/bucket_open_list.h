@@ -0,0 +1,37 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+/*
+  Open list for one or two evaluators with small non-negative integer
+  values, e.g. [f, h] for A*. Entries are kept in an array of buckets
+  indexed by the value of the first evaluator and then by the value of the
+  second evaluator. Each dimension keeps track of its minimum non-empty
+  bucket, so insertion and removal run in amortized constant time.
+
+  Since entries cannot be stored for infinite values, states for which
+  some evaluator is infinite are considered dead ends. For A* with [f, h],
+  this is the same behaviour as the tiebreaking open list without unsafe
+  pruning because f is infinite iff h is infinite.
+*/
+
+namespace bucket_open_list {
+enum class TieBreaking {
+    FIFO,
+    LIFO
+};
+
+class BucketOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit BucketOpenListFactory(const Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
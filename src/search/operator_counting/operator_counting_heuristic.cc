@@ -34,7 +34,7 @@ OperatorCountingHeuristic::~OperatorCountingHeuristic() {
 }
 
 int OperatorCountingHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
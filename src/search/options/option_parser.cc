@@ -173,14 +173,16 @@ shared_ptr<SearchEngine> OptionParser::parse_cmd_line(
 }
 
 shared_ptr<TaskTransformation> OptionParser::parse_cmd_line_transform(
-    int argc, const char **argv, bool dry_run, bool is_unit_cost) {
+    int argc, const char **argv, bool dry_run, bool is_unit_cost,
+    string *transform_config) {
     vector<string> args;
     bool active = true;
     for (int i = 1; i < argc; ++i) {
         string arg = argv[i];
 
-        // Ignore case.
-        transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+        // Ignore case, except for the cache directory.
+        if (i == 1 || static_cast<string>(argv[i - 1]) != "--transform-cache")
+            transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
 
         // Sanitize argument by removing newlines.
         arg.erase(remove(arg.begin(), arg.end(), '\n'), arg.end());
@@ -195,11 +197,11 @@ shared_ptr<TaskTransformation> OptionParser::parse_cmd_line_transform(
             args.push_back(arg);
         }
     }
-    return parse_cmd_line_transform_aux(args, dry_run);
+    return parse_cmd_line_transform_aux(args, dry_run, transform_config);
 }
    
 shared_ptr<TaskTransformation> OptionParser::parse_cmd_line_transform_aux(
-    const vector<string> &args, bool dry_run) {
+    const vector<string> &args, bool dry_run, string *transform_config) {
     shared_ptr<TaskTransformation> task_transformation;
     for (size_t i = 0; i < args.size(); ++i) {
         string arg = args[i];
@@ -210,7 +212,14 @@ shared_ptr<TaskTransformation> OptionParser::parse_cmd_line_transform_aux(
             ++i;
             OptionParser parser(args[i], dry_run);
             task_transformation = parser.start_parsing<shared_ptr<TaskTransformation>>();
-        } 
+            if (transform_config)
+                *transform_config = args[i];
+        } else if (arg == "--transform-cache") {
+            if (is_last)
+                throw ArgError("missing argument after --transform-cache");
+            ++i;
+            g_transform_cache_dir = args[i];
+        }
     }
     return task_transformation;
 }
@@ -254,6 +263,11 @@ shared_ptr<SearchEngine> OptionParser::parse_cmd_line_aux(
             ++i;
             // Do not parse transformation again since we did before already.
             continue;
+        } else if (arg == "--transform-cache") {
+            if (is_last)
+                throw ArgError("missing argument after --transform-cache");
+            ++i;
+            continue;
         } else if (arg == "--help" && dry_run) {
             cout << "Help:" << endl;
             bool txt2tags = false;
@@ -314,6 +328,10 @@ string OptionParser::usage(const string &progname) {
            "--heuristic HEURISTIC_PREDEFINITION\n"
            "    Predefines a heuristic that can afterwards be referenced\n"
            "    by the name that is specified in the definition.\n"
+           "--transform-cache DIRECTORY\n"
+           "    Store the transformed task and its plan reconstruction in\n"
+           "    DIRECTORY and reuse them in later runs with the same task and\n"
+           "    --transform configuration.\n"
            "--internal-plan-file FILENAME\n"
            "    Plan will be output to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
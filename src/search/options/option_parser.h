@@ -39,7 +39,8 @@ class OptionParser {
         const std::vector<std::string> &args, bool dry_run);
 
     static std::shared_ptr<task_transformation::TaskTransformation> parse_cmd_line_transform_aux(
-        const std::vector<std::string> &args, bool dry_run);
+        const std::vector<std::string> &args, bool dry_run,
+        std::string *transform_config);
 
 
 public:
@@ -111,8 +112,13 @@ public:
     static std::shared_ptr<SearchEngine> parse_cmd_line(
         int argc, const char **argv, bool dry_run, bool is_unit_cost);
 
+    /*
+      If transform_config is given, the (normalized) configuration string of
+      the transformation is stored in it.
+    */
     static std::shared_ptr<task_transformation::TaskTransformation> parse_cmd_line_transform(
-        int argc, const char **argv, bool dry_run, bool is_unit_cost);
+        int argc, const char **argv, bool dry_run, bool is_unit_cost,
+        std::string *transform_config = nullptr);
 
     static std::string usage(const std::string &progname);
 };
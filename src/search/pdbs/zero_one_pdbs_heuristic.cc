@@ -27,7 +27,7 @@ ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -13,6 +13,9 @@
 #include "task_transformation/fts_factory.h"
 #include "task_transformation/task_transformation.h"
 #include "task_transformation/plan_reconstruction.h"
+#include "task_transformation/transformation_cache.h"
+
+#include "utils/memory.h"
 
 #include <iostream>
 
@@ -31,7 +34,7 @@ int main(int argc, const char **argv) {
     }
 
     if (static_cast<string>(argv[1]) != "--help") {
-        g_sas_task()->read_from_file(cin);
+        g_sas_task()->read_from_stdin();
         if (g_sas_task()->get_num_axioms()) {
             cerr << "This configuration does not support axioms!"
                  << endl << "Terminating." << endl;
@@ -45,13 +48,15 @@ int main(int argc, const char **argv) {
     }
 
     shared_ptr<TaskTransformation> transformer;
+    string transform_config;
 
     // The command line is parsed twice: once in dry-run mode, to check for simple input
     // errors, and then in normal mode.
     bool is_unit_cost = g_sas_task()->is_unit_cost();
     try {
         OptionParser::parse_cmd_line_transform(argc, argv, true, is_unit_cost);
-        transformer = OptionParser::parse_cmd_line_transform(argc, argv, false, is_unit_cost);
+        transformer = OptionParser::parse_cmd_line_transform(
+            argc, argv, false, is_unit_cost, &transform_config);
     } catch (ArgError &error) {
         cerr << error << endl;
         OptionParser::usage(argv[0]);
@@ -63,8 +68,20 @@ int main(int argc, const char **argv) {
 
     utils::Timer transform_timer;
     if (transformer) {
-        cout << "Transform task... " << endl;
-        auto transformation = transformer->transform_task(g_main_task);
+        unique_ptr<TransformationCache> cache;
+        pair<shared_ptr<FTSTask>, shared_ptr<PlanReconstruction>> transformation;
+        if (!g_transform_cache_dir.empty()) {
+            cache = utils::make_unique_ptr<TransformationCache>(
+                g_transform_cache_dir, *g_main_task, transform_config);
+            transformation = cache->load();
+        }
+        if (!transformation.first) {
+            cout << "Transform task... " << endl;
+            transformation = transformer->transform_task(g_main_task);
+            if (cache) {
+                cache->save(*transformation.first, *transformation.second);
+            }
+        }
         g_main_task = transformation.first;
         g_plan_reconstruction = transformation.second;
         //TODO is_unit_cost = g_main_task->is_unit_cost();
@@ -17,7 +17,7 @@ PotentialHeuristic::~PotentialHeuristic() {
 }
 
 int PotentialHeuristic::compute_heuristic(const GlobalState &global_state) {
-    const State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return max(0, function->get_value(state));
 }
 }
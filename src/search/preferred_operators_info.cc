@@ -9,59 +9,143 @@ using namespace task_transformation;
 using namespace std;
 
 void PreferredOperatorsInfo::clear() {
-    preferred_effects_by_label.clear();
+    preferred_effects.clear();
 }
 
 void PreferredOperatorsInfo::set_preferred(int label, const task_representation::FactPair & fact) {
-    preferred_effects_by_label[label].push_back(fact);
+    preferred_effects.emplace_back(label, fact);
 }
 
-void PreferredOperatorsInfo::get_preferred_operators(const Mapping & mapping,
-                                                     const GlobalState & state,
-                                                     const SearchTask & search_task, 
-                                                     const std::vector<OperatorID> & applicable_operators,
-                                                     ordered_set::OrderedSet<OperatorID> & preferred_operators) const{
+PreferredOperatorsIndex::PreferredOperatorsIndex(
+    const SearchTask &search_task, const Mapping &mapping)
+    : search_task(search_task),
+      mapping(mapping),
+      op_stamp(0),
+      state_stamp(0) {
+    if (mapping.label_mapping) {
+        assert(mapping.state_mapping);
+        abstract_var_by_var = mapping.state_mapping->get_abstract_variable_by_variable(
+            search_task.num_variables());
+        int num_abstract_vars = mapping.state_mapping->get_num_abstract_variables();
+        abstract_var_changed_stamp.resize(num_abstract_vars, 0);
+        abstract_value_stamp.resize(num_abstract_vars, 0);
+        abstract_values.resize(num_abstract_vars);
+    }
+}
 
+int PreferredOperatorsIndex::get_label(OperatorID op_id) const {
+    int label = search_task.get_label(op_id);
     if (mapping.label_mapping) {
-        for (OperatorID op_id : applicable_operators) {
-            int label = mapping.label_mapping->get_reduced_label(search_task.get_label(op_id));
-            auto effects_by_label = preferred_effects_by_label.find(label);
-            if (effects_by_label == preferred_effects_by_label.end()) {
-                continue;
-            }
-            vector<int> state_values = state.get_values();
-            search_task.apply_operator(state, op_id, state_values);
-                
-            for (const FactPair & effect : effects_by_label->second) {
-                //We need to figure out whether applying the operator on state will result in
-                //the relevant effect
-                if(mapping.state_mapping->get_value_abstract_variable(state_values, effect.var)
-                   == effect.value) {
-                    preferred_operators.insert(op_id);
-                    break; 
+        return mapping.label_mapping->get_reduced_label(label);
+    }
+    return label;
+}
+
+bool PreferredOperatorsIndex::achieves_abstract_effect(
+    const GlobalState &state, OperatorID op_id, int first_effect,
+    const PreferredOperatorsInfo &info) {
+    const auto &preferred_effects = info.get_preferred_effects();
+    const StateMapping &state_mapping = *mapping.state_mapping;
+
+    // Apply the operator to values and mark the changed abstract variables
+    ++op_stamp;
+    changed_vars.clear();
+    search_task.apply_effects(state, op_id, [&](int var, int value) {
+            if (values[var] != value) {
+                values[var] = value;
+                changed_vars.push_back(var);
+                int abstract_var = abstract_var_by_var[var];
+                if (abstract_var != -1) {
+                    abstract_var_changed_stamp[abstract_var] = op_stamp;
                 }
             }
-        }
-    }else {
-        for (OperatorID op_id : applicable_operators) {
-            int label = search_task.get_label(op_id);
-            auto effects_by_label = preferred_effects_by_label.find(label);
-            if (effects_by_label == preferred_effects_by_label.end()) {
-                continue;
-            }
-        
-            for (const FactPair & effect : effects_by_label->second) {
-                //We need to figure out whether applying the operator on state will result in
-                //the relevant effect
-
-                if(search_task.has_effect(state, op_id, effect)) {
-                    preferred_operators.insert(op_id);
-                    break; 
-                }
+        });
+
+    bool achieved = false;
+    for (int i = first_effect; i != -1; i = next_effect[i]) {
+        const FactPair &effect = preferred_effects[i].second;
+        int value;
+        if (abstract_var_changed_stamp[effect.var] == op_stamp) {
+            value = state_mapping.get_value_abstract_variable(values, effect.var);
+        } else {
+            // The variables of effect.var have their values in state.
+            if (abstract_value_stamp[effect.var] != state_stamp) {
+                abstract_value_stamp[effect.var] = state_stamp;
+                abstract_values[effect.var] =
+                    state_mapping.get_value_abstract_variable(values, effect.var);
             }
+            value = abstract_values[effect.var];
+        }
+        if (value == effect.value) {
+            achieved = true;
+            break;
         }
     }
-    
-    
+
+    for (int var : changed_vars) {
+        values[var] = state[var];
+    }
+    return achieved;
 }
 
+bool PreferredOperatorsIndex::achieves_effect(
+    const GlobalState &state, OperatorID op_id, int first_effect,
+    const PreferredOperatorsInfo &info) const {
+    const auto &preferred_effects = info.get_preferred_effects();
+    for (int i = first_effect; i != -1; i = next_effect[i]) {
+        if (search_task.has_effect(state, op_id, preferred_effects[i].second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PreferredOperatorsIndex::get_preferred_operators(
+    const PreferredOperatorsInfo &info, const GlobalState &state,
+    const vector<OperatorID> &applicable_operators,
+    ordered_set::OrderedSet<OperatorID> &preferred_operators) {
+    const auto &preferred_effects = info.get_preferred_effects();
+    if (preferred_effects.empty()) {
+        return;
+    }
+
+    // Chain the preferred effects of each label
+    next_effect.resize(preferred_effects.size());
+    for (size_t i = 0; i < preferred_effects.size(); ++i) {
+        int label = preferred_effects[i].first;
+        if (label >= static_cast<int>(first_effect_by_label.size())) {
+            first_effect_by_label.resize(label + 1, -1);
+        }
+        next_effect[i] = first_effect_by_label[label];
+        first_effect_by_label[label] = i;
+    }
+
+    bool is_unpacked = false;
+    for (OperatorID op_id : applicable_operators) {
+        int label = get_label(op_id);
+        if (label >= static_cast<int>(first_effect_by_label.size()) ||
+            first_effect_by_label[label] == -1) {
+            continue;
+        }
+        int first_effect = first_effect_by_label[label];
+
+        bool achieved;
+        if (mapping.label_mapping) {
+            if (!is_unpacked) {
+                state.get_values(values);
+                ++state_stamp;
+                is_unpacked = true;
+            }
+            achieved = achieves_abstract_effect(state, op_id, first_effect, info);
+        } else {
+            achieved = achieves_effect(state, op_id, first_effect, info);
+        }
+        if (achieved) {
+            preferred_operators.insert(op_id);
+        }
+    }
+
+    for (const auto &preferred_effect : preferred_effects) {
+        first_effect_by_label[preferred_effect.first] = -1;
+    }
+}
@@ -4,32 +4,96 @@
 #include "operator_id.h"
 #include "task_representation/fact.h"
 #include "task_transformation/types.h"
-#include "global_state.h" 
-#include <map>
+#include "global_state.h"
 #include "algorithms/ordered_set.h"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace task_representation{
     class   SearchTask;
 }
 
+/*
+  Preferred effects reported by a heuristic for one state: pairs of a label
+  and a fact of the heuristic task. An applicable operator of the search
+  task is preferred if its label is mapped to one of the labels and
+  applying it achieves the corresponding fact.
+*/
 class PreferredOperatorsInfo {
-    task_transformation::Mapping mapping;
-    std::map<int, std::vector<task_representation::FactPair>> preferred_effects_by_label;
-    
+    std::vector<std::pair<int, task_representation::FactPair>> preferred_effects;
+
 public:
 
     bool empty() const{
-        return preferred_effects_by_label.empty();
+        return preferred_effects.empty();
     }
     void clear();
-    
+
     void set_preferred(int label, const task_representation::FactPair & fact_pair);
 
-     void get_preferred_operators(const task_transformation::Mapping & mapping,
+    const std::vector<std::pair<int, task_representation::FactPair>> &
+    get_preferred_effects() const {
+        return preferred_effects;
+    }
+};
+
+/*
+  Computes the preferred operators of a state from a PreferredOperatorsInfo
+  of the heuristic with the given mapping.
+
+  The labels of the search task are mapped with the dense label map of the
+  mapping and the facts are grouped by label in a dense label-indexed array,
+  which is reset after each call. If the heuristic task is an abstraction,
+  the operator effects are applied to a buffer holding the unpacked state,
+  so only the abstract variables containing a changed variable are
+  evaluated on the successor. The values of the other abstract variables do
+  not change and are computed at most once per state. No memory is
+  allocated once the buffers have grown to their final size.
+*/
+class PreferredOperatorsIndex {
+    const task_representation::SearchTask &search_task;
+    task_transformation::Mapping mapping;
+
+    // Abstract variable of each variable of the search task (-1 for none)
+    std::vector<int> abstract_var_by_var;
+
+    // Index into the preferred effects of the first and next fact by label
+    std::vector<int> first_effect_by_label;
+    std::vector<int> next_effect;
+
+    // Unpacked state, temporarily modified by the effects of one operator
+    std::vector<int> values;
+    std::vector<int> changed_vars;
+
+    // Stamps of the current operator and state to avoid clearing arrays
+    std::uint64_t op_stamp;
+    std::uint64_t state_stamp;
+    std::vector<std::uint64_t> abstract_var_changed_stamp;
+    std::vector<std::uint64_t> abstract_value_stamp;
+    std::vector<int> abstract_values;
+
+    int get_label(OperatorID op_id) const;
+    bool achieves_abstract_effect(const GlobalState &state, OperatorID op_id,
+                                  int first_effect,
+                                  const PreferredOperatorsInfo &info);
+    bool achieves_effect(const GlobalState &state, OperatorID op_id,
+                         int first_effect,
+                         const PreferredOperatorsInfo &info) const;
+
+public:
+    PreferredOperatorsIndex(const task_representation::SearchTask &search_task,
+                            const task_transformation::Mapping &mapping);
+
+    const task_representation::SearchTask &get_search_task() const {
+        return search_task;
+    }
+
+    void get_preferred_operators(const PreferredOperatorsInfo &info,
                                  const GlobalState & state,
-                                 const task_representation::SearchTask & search_task, 
                                  const std::vector<OperatorID> & applicable_operators,
-                                 ordered_set::OrderedSet<OperatorID> & result_preferred_operators) const;
+                                 ordered_set::OrderedSet<OperatorID> & result_preferred_operators);
 };
 
 #endif
@@ -29,7 +29,8 @@ SearchEngine::SearchEngine(const Options &opts)
       plan(g_main_task.get()),
       state_registry(g_main_task->get_search_task(true)),
       search_space(state_registry,
-                   static_cast<OperatorCost>(opts.get_enum("cost_type"))),
+                   static_cast<OperatorCost>(opts.get_enum("cost_type")),
+                   opts.get<bool>("compact_search_nodes")),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       max_time(opts.get<double>("max_time")),
       task(g_main_task->get_search_task()) {
@@ -38,6 +39,9 @@ SearchEngine::SearchEngine(const Options &opts)
         utils::exit_with(ExitCode::INPUT_ERROR);
     }
     bound = opts.get<int>("bound");
+    task->set_successor_generator_type(
+        static_cast<task_representation::SuccessorGeneratorType>(
+            opts.get_enum("successor_generator")));
 }
 
 SearchEngine::~SearchEngine() {
@@ -130,6 +134,28 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<bool>(
+        "compact_search_nodes",
+        "store the search node information of each state compactly: "
+        "bit-pack the creating operator and omit the real g value if it "
+        "always equals g under the cost type",
+        "true");
+    vector<string> successor_generators;
+    vector<string> successor_generators_doc;
+    successor_generators.push_back("BITSET");
+    successor_generators_doc.push_back(
+        "intersect one bitset of activated labels per variable");
+    successor_generators.push_back("DECISION_TREE");
+    successor_generators_doc.push_back(
+        "decision tree over the variables built from the label preconditions; "
+        "the time per expansion depends on the number of applicable operators "
+        "rather than on the number of labels");
+    parser.add_enum_option(
+        "successor_generator",
+        successor_generators,
+        "method to compute the applicable operators of a state",
+        "BITSET",
+        successor_generators_doc);
 }
 
 /* Method doesn't belong here because it's only useful for certain derived classes.
@@ -0,0 +1,492 @@
+#include "hda_star_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../globals.h"
+#include "../heuristic.h"
+#include "../open_list.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+
+#include "../algorithms/spsc_queue.h"
+#include "../task_representation/fts_task.h"
+#include "../task_representation/search_task.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/hash.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_star_search {
+enum class NodeStatus {
+    NEW,
+    OPEN,
+    CLOSED,
+    DEAD_END
+};
+
+/*
+  Search node information of a state owned by a worker. The parent state
+  is identified by the thread owning it and its ID in the state registry
+  of that thread.
+*/
+struct NodeInfo {
+    NodeStatus status;
+    int g;
+    int real_g;
+    int parent_thread;
+    int parent_state;
+    int creating_operator;
+
+    NodeInfo()
+        : status(NodeStatus::NEW),
+          g(-1),
+          real_g(-1),
+          parent_thread(-1),
+          parent_state(-1),
+          creating_operator(-1) {
+    }
+};
+
+struct Worker {
+    const int id;
+    StateRegistry state_registry;
+    PerStateInformation<NodeInfo> node_infos;
+    unique_ptr<StateOpenList> open_list;
+    vector<Heuristic *> heuristics;
+    SearchStatistics statistics;
+
+    // incoming[i] holds the states sent by worker i.
+    vector<unique_ptr<spsc_queue::SPSCQueue<PackedStateBin>>> incoming;
+
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> message;
+
+    // Communication statistics
+    int num_sent;
+    int num_received;
+    int num_local;
+
+    Worker(int id, const shared_ptr<task_representation::SearchTask> &task)
+        : id(id),
+          state_registry(task),
+          num_sent(0),
+          num_received(0),
+          num_local(0) {
+    }
+};
+
+HDAStarSearch::HDAStarSearch(const Options &opts)
+    : SearchEngine(opts),
+      eval_config(opts.get<ParseTree>("eval")),
+      bucket_open_list(search_common::use_bucket_open_list(opts)),
+      num_threads(opts.get<int>("threads")),
+      num_bins(state_registry.get_state_packer().get_num_bins()),
+      num_idle(0),
+      num_in_flight(0),
+      activity(0),
+      done(false),
+      timed_out(false),
+      incumbent_cost(numeric_limits<int>::max()),
+      goal_thread(-1),
+      goal_state(-1) {
+    for (int i = 0; i < num_threads; ++i) {
+        workers.push_back(create_worker(i));
+    }
+    int record_size = MESSAGE_HEADER_SIZE + num_bins;
+    for (auto &worker : workers) {
+        for (int sender = 0; sender < num_threads; ++sender) {
+            worker->incoming.push_back(
+                utils::make_unique_ptr<spsc_queue::SPSCQueue<PackedStateBin>>(
+                    record_size));
+        }
+        worker->message.resize(record_size);
+    }
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+unique_ptr<Worker> HDAStarSearch::create_worker(int id) {
+    unique_ptr<Worker> worker = utils::make_unique_ptr<Worker>(id, task);
+
+    /*
+      Heuristics keep per-state caches and computation buffers, so every
+      thread parses its own copy of the evaluator.
+    */
+    OptionParser parser(eval_config, false);
+    Evaluator *eval = parser.start_parsing<Evaluator *>();
+    for (const auto &other : workers) {
+        set<Heuristic *> hset;
+        other->open_list->get_involved_heuristics(hset);
+        set<Heuristic *> own_hset;
+        eval->get_involved_heuristics(own_hset);
+        for (Heuristic *heuristic : own_hset) {
+            if (hset.count(heuristic)) {
+                cerr << "hdastar needs one evaluator per thread and cannot "
+                     << "use predefined heuristics" << endl;
+                utils::exit_with(utils::ExitCode::INPUT_ERROR);
+            }
+        }
+    }
+
+    Options opts;
+    opts.set("eval", eval);
+    opts.set("bucket_open_list", static_cast<int>(
+                 bucket_open_list ? search_common::BucketOpenListChoice::ALWAYS
+                 : search_common::BucketOpenListChoice::NEVER));
+    worker->open_list = search_common::create_astar_open_list_factory_and_f_eval(
+        opts).first->create_state_open_list();
+
+    set<Heuristic *> hset;
+    worker->open_list->get_involved_heuristics(hset);
+    worker->heuristics.assign(hset.begin(), hset.end());
+    /*
+      The parent of a state may be owned by another thread, whose copy of
+      the heuristic holds the path information, so path-dependent
+      heuristics cannot be updated on state transitions.
+    */
+    for (Heuristic *heuristic : worker->heuristics) {
+        if (heuristic->is_path_dependent()) {
+            cerr << "hdastar does not support path-dependent heuristics: "
+                 << heuristic->get_description() << endl;
+            utils::exit_with(utils::ExitCode::INPUT_ERROR);
+        }
+    }
+    return worker;
+}
+
+int HDAStarSearch::get_owner(const PackedStateBin *buffer) const {
+    utils::HashState hash_state;
+    for (int i = 0; i < num_bins; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    /*
+      The state registries use the lower 32 bits of the same hash function,
+      so we use the upper bits to distribute states over the threads.
+    */
+    return (hash_state.get_hash64() >> 32) % num_threads;
+}
+
+void HDAStarSearch::initialize() {
+    cout << "Conducting hash-distributed A* search with " << num_threads
+         << " threads, (real) bound = " << bound << endl;
+
+    const GlobalState &initial_state = state_registry.get_initial_state();
+
+    Worker &owner = *workers[get_owner(initial_state.get_packed_buffer())];
+    GlobalState state = owner.state_registry.register_state(
+        initial_state.get_packed_buffer());
+
+    EvaluationContext eval_context(state, 0, true, &owner.statistics);
+    owner.statistics.inc_evaluated_states();
+    NodeInfo &info = owner.node_infos[state];
+    if (owner.open_list->is_dead_end(eval_context)) {
+        cout << "Initial state is a dead end." << endl;
+        info.status = NodeStatus::DEAD_END;
+        owner.statistics.inc_dead_ends();
+    } else {
+        info.status = NodeStatus::OPEN;
+        info.g = 0;
+        info.real_g = 0;
+        owner.open_list->insert(eval_context, state.get_id());
+    }
+    print_initial_h_values(eval_context);
+}
+
+void HDAStarSearch::handle_successor(
+    Worker &worker, const PackedStateBin *buffer, int parent_thread,
+    int parent_state, int creating_operator, int g, int real_g) {
+    if (g >= incumbent_cost.load(memory_order_relaxed))
+        return;
+    GlobalState state = worker.state_registry.register_state(buffer);
+    NodeInfo &info = worker.node_infos[state];
+    if (info.status == NodeStatus::DEAD_END)
+        return;
+    if (info.status != NodeStatus::NEW && g >= info.g)
+        return;
+
+    EvaluationContext eval_context(state, g, false, &worker.statistics);
+    if (info.status == NodeStatus::NEW) {
+        worker.statistics.inc_evaluated_states();
+        if (worker.open_list->is_dead_end(eval_context)) {
+            info.status = NodeStatus::DEAD_END;
+            worker.statistics.inc_dead_ends();
+            return;
+        }
+    } else if (info.status == NodeStatus::CLOSED) {
+        worker.statistics.inc_reopened();
+    }
+    info.status = NodeStatus::OPEN;
+    info.g = g;
+    info.real_g = real_g;
+    info.parent_thread = parent_thread;
+    info.parent_state = parent_state;
+    info.creating_operator = creating_operator;
+    worker.open_list->insert(eval_context, state.get_id());
+}
+
+bool HDAStarSearch::receive_messages(Worker &worker) {
+    bool received = false;
+    for (int sender = 0; sender < num_threads; ++sender) {
+        spsc_queue::SPSCQueue<PackedStateBin> &queue = *worker.incoming[sender];
+        while (const PackedStateBin *record = queue.front()) {
+            handle_successor(
+                worker, record + MESSAGE_HEADER_SIZE, sender,
+                record[0], record[1], record[2], record[3]);
+            queue.pop();
+            ++worker.num_received;
+            /*
+              Successors of this state are only generated while it is in
+              the open list, which the termination check sees because
+              this worker is not idle.
+            */
+            num_in_flight.fetch_sub(1);
+            received = true;
+        }
+    }
+    return received;
+}
+
+void HDAStarSearch::report_goal(Worker &worker, const GlobalState &state, int g) {
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (g < incumbent_cost.load()) {
+        incumbent_cost.store(g);
+        goal_thread = worker.id;
+        goal_state = state_id_to_int(state.get_id());
+    }
+}
+
+void HDAStarSearch::expand(Worker &worker) {
+    vector<int> key;
+    StateID id = worker.open_list->remove_min(&key);
+    if (key[0] >= incumbent_cost.load(memory_order_relaxed)) {
+        // All remaining states have f >= incumbent cost.
+        worker.open_list->clear();
+        return;
+    }
+    GlobalState state = worker.state_registry.lookup_state(id);
+    NodeInfo &info = worker.node_infos[state];
+    if (info.status == NodeStatus::CLOSED)
+        return;
+    assert(info.status == NodeStatus::OPEN);
+    info.status = NodeStatus::CLOSED;
+    int g = info.g;
+    int real_g = info.real_g;
+
+    if (task->is_goal_state(state)) {
+        report_goal(worker, state, g);
+        return;
+    }
+    worker.statistics.inc_expanded();
+
+    worker.applicable_ops.clear();
+    task->generate_applicable_ops(state, worker.applicable_ops);
+    worker.statistics.inc_generated_ops(worker.applicable_ops.size());
+
+    vector<PackedStateBin> &message = worker.message;
+    PackedStateBin *buffer = message.data() + MESSAGE_HEADER_SIZE;
+    const PackedStateBin *parent_buffer = state.get_packed_buffer();
+    int parent_state = state_id_to_int(id);
+    for (OperatorID op_id : worker.applicable_ops) {
+        int cost = task->get_operator_cost(op_id);
+        int succ_g = g + get_adjusted_cost(cost);
+        int succ_real_g = real_g + cost;
+        if (succ_real_g >= bound ||
+            succ_g >= incumbent_cost.load(memory_order_relaxed))
+            continue;
+        worker.statistics.inc_generated();
+
+        copy(parent_buffer, parent_buffer + num_bins, buffer);
+        task->apply_operator(op_id, buffer);
+        int owner = get_owner(buffer);
+        if (owner == worker.id) {
+            ++worker.num_local;
+            handle_successor(worker, buffer, worker.id, parent_state,
+                             op_id.get_index(), succ_g, succ_real_g);
+        } else {
+            message[0] = parent_state;
+            message[1] = op_id.get_index();
+            message[2] = succ_g;
+            message[3] = succ_real_g;
+            ++worker.num_sent;
+            num_in_flight.fetch_add(1);
+            workers[owner]->incoming[worker.id]->push(message.data());
+        }
+    }
+}
+
+bool HDAStarSearch::check_termination() const {
+    /*
+      A worker that becomes busy first leaves the idle count, then
+      increments the activity counter and only afterwards finishes the
+      message that woke it up. If all workers are idle when we look and
+      no message is in flight afterwards, either nobody woke up in
+      between, or the activity counter has changed.
+    */
+    int activity_before = activity.load();
+    if (num_idle.load() != num_threads)
+        return false;
+    if (num_in_flight.load() != 0)
+        return false;
+    return activity.load() == activity_before;
+}
+
+void HDAStarSearch::run_worker(Worker &worker) {
+    // CPU time grows with the number of threads, so we limit wall-clock time.
+    utils::WallClockCountdownTimer timer(max_time);
+    bool idle = false;
+    while (!done.load(memory_order_relaxed)) {
+        if (worker.id == 0 && timer.is_expired()) {
+            timed_out = true;
+            done.store(true);
+            break;
+        }
+        if (idle) {
+            bool has_message = false;
+            for (auto &queue : worker.incoming) {
+                if (queue->front()) {
+                    has_message = true;
+                    break;
+                }
+            }
+            if (!has_message) {
+                if (check_termination())
+                    done.store(true);
+                else
+                    this_thread::yield();
+                continue;
+            }
+            idle = false;
+            num_idle.fetch_sub(1);
+            activity.fetch_add(1);
+        }
+        bool received = receive_messages(worker);
+        if (!worker.open_list->empty()) {
+            expand(worker);
+        } else if (!received) {
+            idle = true;
+            num_idle.fetch_add(1);
+        }
+    }
+}
+
+SearchStatus HDAStarSearch::step() {
+    vector<thread> threads;
+    for (int i = 1; i < num_threads; ++i) {
+        threads.emplace_back(&HDAStarSearch::run_worker, this, ref(*workers[i]));
+    }
+    run_worker(*workers[0]);
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    for (const auto &worker : workers) {
+        const SearchStatistics &stats = worker->statistics;
+        statistics.inc_expanded(stats.get_expanded());
+        statistics.inc_evaluated_states(stats.get_evaluated_states());
+        statistics.inc_evaluations(stats.get_evaluations());
+        statistics.inc_generated(stats.get_generated());
+        statistics.inc_reopened(stats.get_reopened());
+        statistics.inc_generated_ops(stats.get_generated_ops());
+        statistics.inc_dead_ends(stats.get_dead_ends());
+    }
+
+    if (timed_out)
+        return TIMEOUT;
+    if (goal_thread == -1) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    set_plan_from_goal();
+    return SOLVED;
+}
+
+void HDAStarSearch::set_plan_from_goal() {
+    vector<PlanState> states;
+    vector<OperatorID> ops;
+    int thread = goal_thread;
+    StateID id = int_to_state_id(goal_state);
+    while (true) {
+        Worker &worker = *workers[thread];
+        GlobalState state = worker.state_registry.lookup_state(id);
+        states.push_back(PlanState(state));
+        const NodeInfo &info = worker.node_infos[state];
+        if (info.creating_operator == -1)
+            break;
+        ops.push_back(OperatorID(info.creating_operator));
+        thread = info.parent_thread;
+        id = int_to_state_id(info.parent_state);
+    }
+    reverse(states.begin(), states.end());
+    reverse(ops.begin(), ops.end());
+    check_goal_and_set_plan(states.back(), states, ops, g_main_task);
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (const auto &worker : workers) {
+        const SearchStatistics &stats = worker->statistics;
+        cout << "Thread " << worker->id << ": "
+             << stats.get_expanded() << " expanded, "
+             << stats.get_evaluated_states() << " evaluated, "
+             << stats.get_generated() << " generated ("
+             << worker->num_local << " local, "
+             << worker->num_sent << " sent), "
+             << worker->num_received << " received, "
+             << worker->state_registry.size() << " registered states" << endl;
+    }
+    SearchEngine::print_statistics();
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search (HDA*)",
+        "Parallel A* search in which every state is owned by one thread "
+        "according to a hash of the state. Each thread has its own state "
+        "registry, open list and copy of the evaluator and sends generated "
+        "states to their owner through lock-free queues. Closed nodes are "
+        "re-opened. For admissible heuristics, the plan is optimal.");
+    parser.document_note(
+        "Path-dependent heuristics",
+        "Heuristics that depend on the path to a state, such as the landmark "
+        "count heuristic, are not supported, because the parent of a state "
+        "can be owned by another thread.");
+    parser.document_note(
+        "Evaluator copies",
+        "The evaluator is parsed once for every thread, so its preprocessing "
+        "(e.g. building a merge-and-shrink abstraction) is also performed "
+        "once for every thread. Predefined heuristics cannot be used.");
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "threads", "number of search threads", "1", Bounds("1", "infinity"));
+    search_common::add_bucket_open_list_option_to_parser(
+        parser,
+        "store the open lists in arrays of buckets indexed by f and h "
+        "instead of tie-breaking open lists (see astar)");
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        OptionParser test_parser(opts.get<ParseTree>("eval"), true);
+        test_parser.start_parsing<Evaluator *>();
+        return nullptr;
+    } else {
+        return make_shared<HDAStarSearch>(opts);
+    }
+}
+
+static PluginShared<SearchEngine> _plugin("hdastar", _parse);
+}
@@ -0,0 +1,93 @@
+#ifndef SEARCH_ENGINES_HDA_STAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_STAR_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace hda_star_search {
+struct Worker;
+
+/*
+  Parallel A* with hash-distributed state ownership (HDA*).
+
+  Every state is owned by exactly one thread, determined by a hash of its
+  packed state data. Each thread has its own state registry, search node
+  information, open list and copy of the heuristic, so threads only share
+  the (read-only) search task. When a thread generates a successor that is
+  owned by another thread, it sends the packed state together with the
+  path information to the owner through a lock-free single-producer
+  single-consumer queue. The owner evaluates and inserts the state like A*
+  with reopening would.
+
+  A goal state is accepted when it is expanded. Its cost is the incumbent
+  solution cost, which is shared by all threads and used to prune states
+  with f >= incumbent. The search terminates once all threads are idle
+  (their open lists are empty) and no message is in flight. For admissible
+  heuristics, the incumbent solution is then optimal.
+*/
+class HDAStarSearch : public SearchEngine {
+    const options::ParseTree eval_config;
+    const bool bucket_open_list;
+    const int num_threads;
+    // Number of PackedStateBins in front of the state data of a message.
+    static const int MESSAGE_HEADER_SIZE = 4;
+    int num_bins;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Termination detection, see run_worker().
+    std::atomic<int> num_idle;
+    std::atomic<int> num_in_flight;
+    std::atomic<int> activity;
+    std::atomic<bool> done;
+    bool timed_out;
+
+    std::mutex incumbent_mutex;
+    std::atomic<int> incumbent_cost;
+    int goal_thread;
+    int goal_state;
+
+    std::unique_ptr<Worker> create_worker(int id);
+    int get_owner(const PackedStateBin *buffer) const;
+
+    void handle_successor(
+        Worker &worker, const PackedStateBin *buffer, int parent_thread,
+        int parent_state, int creating_operator, int g, int real_g);
+    bool receive_messages(Worker &worker);
+    void expand(Worker &worker);
+    void report_goal(Worker &worker, const GlobalState &state, int g);
+    bool check_termination() const;
+    void run_worker(Worker &worker);
+
+    void set_plan_from_goal();
+
+    static int state_id_to_int(StateID id) {
+        return id.value;
+    }
+
+    static StateID int_to_state_id(int value) {
+        return StateID(value);
+    }
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit HDAStarSearch(const options::Options &opts);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -24,12 +24,23 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "\n```\n--search astar(evaluator)\n```\n"
         "is equivalent to\n"
         "```\n--heuristic h=evaluator\n"
+        "--search eager(bucket([sum([g(), h]), h]),\n"
+        "               reopen_closed=true, f_eval=sum([g(), h]))\n"
+        "```\n"
+        "and with bucket_open_list=never to\n"
+        "```\n--heuristic h=evaluator\n"
         "--search eager(tiebreaking([sum([g(), h]), h], unsafe_pruning=false),\n"
         "               reopen_closed=true, f_eval=sum([g(), h]))\n"
         "```\n", true);
     parser.add_option<Evaluator *>("eval", "evaluator for h-value");
     parser.add_option<bool>("mpd",
                             "use multi-path dependence (LM-A*)", "false");
+    search_common::add_bucket_open_list_option_to_parser(
+        parser,
+        "store the open list in an array of buckets indexed by f and h "
+        "instead of a tie-breaking open list; all evaluators are integral, "
+        "but the array grows with the largest f-value, so by default this "
+        "is only done for tasks with small operator costs");
 
     SearchEngine::add_pruning_option(parser);
     SearchEngine::add_options_to_parser(parser);
@@ -1,6 +1,9 @@
 #include "search_common.h"
 
+#include "../globals.h"
 #include "../open_list_factory.h"
+#include "../operator_cost.h"
+#include "../option_parser.h"
 #include "../option_parser_util.h"
 
 #include "../evaluators/g_evaluator.h"
@@ -8,9 +11,13 @@
 #include "../evaluators/weighted_evaluator.h"
 
 #include "../open_lists/alternation_open_list.h"
+#include "../open_lists/bucket_open_list.h"
 #include "../open_lists/standard_scalar_open_list.h"
 #include "../open_lists/tiebreaking_open_list.h"
 
+#include "../task_representation/fts_task.h"
+#include "../task_representation/search_task.h"
+
 #include <memory>
 
 using namespace std;
@@ -109,6 +116,55 @@ shared_ptr<OpenListFactory> create_wastar_open_list_factory(
         options.get<int>("boost"));
 }
 
+void add_bucket_open_list_option_to_parser(
+    OptionParser &parser, const string &help) {
+    vector<string> choices;
+    vector<string> choices_doc;
+    choices.push_back("NEVER");
+    choices_doc.push_back("use a tie-breaking open list");
+    choices.push_back("ALWAYS");
+    choices_doc.push_back("use a bucket open list");
+    choices.push_back("AUTO");
+    choices_doc.push_back(
+        "use a bucket open list if no operator costs more than "
+        "bucket_max_operator_cost under the cost type");
+    parser.add_enum_option(
+        "bucket_open_list", choices, help, "AUTO", choices_doc);
+    /*
+      The array has an empty layer of 32 bytes for every f-value below the
+      largest one inserted, so with operator costs of at most c it takes
+      about 32 * c bytes per step of the longest path in the open list.
+      For the default, that is 3.2 KB per step, i.e. a few MB for paths
+      of a thousand steps, which is small compared to the state registry.
+    */
+    parser.add_option<int>(
+        "bucket_max_operator_cost",
+        "largest operator cost for which bucket_open_list=auto uses a "
+        "bucket open list. The array of buckets needs about "
+        "32 * bucket_max_operator_cost bytes per step of the longest path "
+        "in the open list.",
+        "100",
+        Bounds("0", "infinity"));
+}
+
+bool use_bucket_open_list(const Options &opts) {
+    BucketOpenListChoice choice =
+        static_cast<BucketOpenListChoice>(opts.get_enum("bucket_open_list"));
+    if (choice != BucketOpenListChoice::AUTO) {
+        return choice == BucketOpenListChoice::ALWAYS;
+    }
+    int max_operator_cost = opts.get<int>("bucket_max_operator_cost");
+    OperatorCost cost_type = static_cast<OperatorCost>(opts.get_enum("cost_type"));
+    shared_ptr<task_representation::SearchTask> task = g_main_task->get_search_task();
+    for (int op = 0; op < task->num_operators(); ++op) {
+        int cost = task->get_operator_cost(OperatorID(op));
+        if (get_adjusted_action_cost(cost, cost_type) > max_operator_cost) {
+            return false;
+        }
+    }
+    return true;
+}
+
 pair<shared_ptr<OpenListFactory>, Evaluator *>
 create_astar_open_list_factory_and_f_eval(const Options &opts) {
     GEval *g = new GEval();
@@ -119,9 +175,15 @@ create_astar_open_list_factory_and_f_eval(const Options &opts) {
     Options options;
     options.set("evals", evals);
     options.set("pref_only", false);
-    options.set("unsafe_pruning", false);
-    shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    shared_ptr<OpenListFactory> open;
+    if (use_bucket_open_list(opts)) {
+        options.set("tie_breaking",
+                    static_cast<int>(bucket_open_list::TieBreaking::FIFO));
+        open = make_shared<bucket_open_list::BucketOpenListFactory>(options);
+    } else {
+        options.set("unsafe_pruning", false);
+        open = make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    }
     return make_pair(open, f);
 }
 }
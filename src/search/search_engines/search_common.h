@@ -19,11 +19,13 @@
 */
 
 #include <memory>
+#include <string>
 
 class Evaluator;
 class OpenListFactory;
 
 namespace options {
+class OptionParser;
 class Options;
 }
 
@@ -67,13 +69,35 @@ extern std::shared_ptr<OpenListFactory> create_greedy_open_list_factory(
 extern std::shared_ptr<OpenListFactory> create_wastar_open_list_factory(
     const options::Options &opts);
 
+/*
+  Values of the "bucket_open_list" option. With AUTO, a bucket open list
+  is only used if no operator costs more than the
+  "bucket_max_operator_cost" option under the cost type, because its
+  array of buckets grows with the largest f-value.
+*/
+enum class BucketOpenListChoice {
+    NEVER,
+    ALWAYS,
+    AUTO
+};
+
+extern void add_bucket_open_list_option_to_parser(
+    options::OptionParser &parser, const std::string &help);
+
+/*
+  Decide whether to use a bucket open list. Resolving AUTO needs the
+  "cost_type" and "bucket_max_operator_cost" options.
+*/
+extern bool use_bucket_open_list(const options::Options &opts);
+
 /*
   Create open list factory and f_evaluator (used for displaying progress
   statistics) for A* search.
 
-  The resulting open list factory produces a tie-breaking open list
-  ordered primarily on g + h and secondarily on h. Uses "eval" from
-  the passed-in Options object as the h evaluator.
+  The resulting open list factory produces an open list ordered primarily
+  on g + h and secondarily on h. Uses "eval" from the passed-in Options
+  object as the h evaluator. Depending on use_bucket_open_list, the open
+  list is a bucket open list or a tie-breaking open list.
 */
 extern std::pair<std::shared_ptr<OpenListFactory>, Evaluator *>
 create_astar_open_list_factory_and_f_eval(const options::Options &opts);
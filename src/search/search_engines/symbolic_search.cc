@@ -11,6 +11,7 @@
 #include "../symbolic/original_state_space.h"
 #include "../symbolic/uniform_cost_search.h"
 #include "../symbolic/bidirectional_search.h"
+#include "../symbolic/parallel_bidirectional_search.h"
 #include "../task_representation/search_task.h"
 #include "../task_representation/sas_task.h"
 #include "../task_representation/sas_operator.h"
@@ -25,15 +26,37 @@ using namespace options;
 
 namespace symbolic_search {
 
-    SymbolicSearch::SymbolicSearch(const options::Options &opts) :
-            SearchEngine(opts), SymController(opts, g_main_task), task(g_main_task) { }
+    SymbolicSearch::SymbolicSearch(const options::Options &opts, int num_managers) :
+            SearchEngine(opts), SymController(opts, g_main_task, num_managers), task(g_main_task) { }
 
     SymbolicBidirectionalUniformCostSearch::SymbolicBidirectionalUniformCostSearch(const options::Options &opts) :
-            SymbolicSearch(opts) {
+            // The parallel search splits the CUDD memory between two managers
+            SymbolicSearch(opts, opts.get<bool>("parallel") ? 2 : 1),
+            bw_vars(opts.get<bool>("parallel") ? make_shared<SymVariables>(opts, task, 2) : nullptr) {
     }
 
     void SymbolicBidirectionalUniformCostSearch::initialize() {
         mgr = make_shared<OriginalStateSpace>(vars.get(), mgrParams, task);
+        if (bw_vars) {
+            // Each direction searches with its own manager and keeps a
+            // mirror of the closed list of the other direction in it.
+            bw_vars->init(*vars);
+            auto bw_mgr = make_shared<OriginalStateSpace>(bw_vars.get(), mgrParams, task);
+            auto fw_search = make_unique<UniformCostSearch>(this, searchParams, task);
+            auto fw_opposite = make_unique<UniformCostSearch>(this, searchParams, task);
+            auto bw_search = make_unique<UniformCostSearch>(this, searchParams, task);
+            auto bw_opposite = make_unique<UniformCostSearch>(this, searchParams, task);
+            fw_opposite->init(mgr, false);
+            fw_search->init(mgr, true, fw_opposite->getClosedShared());
+            bw_opposite->init(bw_mgr, true);
+            bw_search->init(bw_mgr, false, bw_opposite->getClosedShared());
+
+            search = make_unique<ParallelBidirectionalSearch>(
+                this, searchParams,
+                vars, move(fw_search), move(fw_opposite),
+                bw_vars, move(bw_search), move(bw_opposite), max_time);
+            return;
+        }
         auto fw_search = make_unique<UniformCostSearch>(this, searchParams, task);
         auto bw_search = make_unique<UniformCostSearch>(this, searchParams, task);
         fw_search->init(mgr, true, bw_search->getClosedShared());
@@ -63,6 +86,7 @@ namespace symbolic_search {
 
     SearchStatus SymbolicSearch::step() {
         search->step();
+        vars->reorder_if_grown();
 
         if (getLowerBound() < getUpperBound()) {
             return IN_PROGRESS;
@@ -74,22 +98,54 @@ namespace symbolic_search {
         }
     }
 
+    void SymbolicSearch::set_plan(const SymSolution &sol) {
+        vector<PlanState> states;
+        vector<OperatorID> plan;
+        sol.getPlan(states, plan);
+        this->check_goal_and_set_plan(states.back(), states, plan, task);
+    }
+
     void SymbolicSearch::new_solution(const SymSolution &sol) {
         if (sol.getCost() < getUpperBound()) {
-            vector<PlanState> states;
-            vector<OperatorID> plan;
-            sol.getPlan(states, plan);
-            this->check_goal_and_set_plan(states.back(), states, plan, task);
+            set_plan(sol);
         }
 
         SymController::new_solution(sol);
     }
+
+    void SymbolicBidirectionalUniformCostSearch::new_solution(const SymSolution &sol) {
+        if (!bw_vars) {
+            SymbolicSearch::new_solution(sol);
+            return;
+        }
+        // The cut belongs to the manager of the reporting thread, so the
+        // plan is extracted right away and only the cost is kept.
+        lock_guard<mutex> lock(solution_mutex);
+        if (sol.getCost() < getUpperBound()) {
+            set_plan(sol);
+        }
+        SymController::new_solution(sol.withoutCut());
+    }
+
+    void SymbolicSearch::print_statistics() const {
+        SearchEngine::print_statistics();
+        search->statistics();
+        cout << "Total BDD nodes: " << vars->totalNodes() << endl;
+        vars->print_reordering_statistics();
+    }
 }
 
 static shared_ptr<SearchEngine> _parse_bidirectional_ucs(OptionParser &parser) {
     parser.document_synopsis("Symbolic Bidirectional Uniform Cost Search", "");
 
     SearchEngine::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "parallel",
+        "run the forward and backward search in two threads, each with a "
+        "CUDD manager of its own. Both managers get half of "
+        "cudd_init_available_memory (or of the default limit of CUDD). "
+        "The time limit is measured in wall-clock time.",
+        "false");
     SymVariables::add_options_to_parser(parser);
     SymParamsSearch::add_options_to_parser(parser, 30e3, 10e7);
     SymParamsMgr::add_options_to_parser(parser);
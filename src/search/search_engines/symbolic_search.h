@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "../symbolic/sym_controller.h"
 #include "../symbolic/sym_enums.h"
@@ -17,6 +18,8 @@ namespace symbolic {
 
     class SymSearch;
 
+    class SymVariables;
+
     class SymSolution;
 
 }
@@ -33,22 +36,33 @@ namespace symbolic_search {
 
         virtual SearchStatus step() override;
 
+        // Extracts the plan of sol and sets it as the plan of the engine
+        void set_plan(const symbolic::SymSolution &sol);
+
     public:
-        SymbolicSearch(const options::Options &opts);
+        SymbolicSearch(const options::Options &opts, int num_managers = 1);
 
         virtual ~SymbolicSearch() = default ;
 
         virtual void new_solution(const symbolic::SymSolution &sol) override;
+
+        virtual void print_statistics() const override;
     };
 
 
     class SymbolicBidirectionalUniformCostSearch : public SymbolicSearch {
+        // Variables with a CUDD manager of their own for the backward
+        // search, if both directions run in parallel
+        std::shared_ptr<symbolic::SymVariables> bw_vars;
+        std::mutex solution_mutex;
     protected:
         virtual void initialize() override;
 
     public:
         SymbolicBidirectionalUniformCostSearch(const options::Options &opts);
 
+        virtual void new_solution(const symbolic::SymSolution &sol) override;
+
         ~SymbolicBidirectionalUniformCostSearch() override = default;
     };
 
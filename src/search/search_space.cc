@@ -11,19 +11,31 @@
 
 using namespace std;
 
-SearchNode::SearchNode(const StateRegistry &state_registry,
+static int compute_bits_for_range(int range) {
+    int bits = 1;
+    while (bits < 32 && (1U << bits) < static_cast<unsigned int>(range)) {
+        ++bits;
+    }
+    return bits;
+}
+
+SearchNode::SearchNode(SearchSpace &search_space,
                        StateID state_id,
-                       SearchNodeInfo &info,
+                       const SearchNodeInfo &info,
                        OperatorCost cost_type)
-    : state_registry(state_registry),
+    : search_space(search_space),
       state_id(state_id),
       info(info),
       cost_type(cost_type) {
     assert(state_id != StateID::no_state);
 }
 
+void SearchNode::save_info() {
+    search_space.set_info(state_id, info);
+}
+
 GlobalState SearchNode::get_state() const {
-    return state_registry.lookup_state(state_id);
+    return search_space.state_registry.lookup_state(state_id);
 }
 
 bool SearchNode::is_open() const {
@@ -58,6 +70,7 @@ void SearchNode::open_initial() {
     info.real_g = 0;
     info.parent_state_id = StateID::no_state;
     info.creating_operator = -1;
+    save_info();
 }
 
 void SearchNode::open(const SearchNode &parent_node, OperatorID creating_operator, int cost) {
@@ -67,6 +80,7 @@ void SearchNode::open(const SearchNode &parent_node, OperatorID creating_operato
     info.real_g = parent_node.info.real_g + cost;
     info.parent_state_id = parent_node.get_state_id();
     info.creating_operator = creating_operator.get_index();
+    save_info();
 }
 
 void SearchNode::reopen(const SearchNode &parent_node, OperatorID creating_operator, int cost) {
@@ -80,6 +94,7 @@ void SearchNode::reopen(const SearchNode &parent_node, OperatorID creating_opera
     info.real_g = parent_node.info.real_g + cost;
     info.parent_state_id = parent_node.get_state_id();
     info.creating_operator = creating_operator.get_index();
+    save_info();
 }
 
 // like reopen, except doesn't change status
@@ -92,15 +107,18 @@ void SearchNode::update_parent(const SearchNode &parent_node, OperatorID creatin
     info.real_g = parent_node.info.real_g + cost;
     info.parent_state_id = parent_node.get_state_id();
     info.creating_operator = creating_operator.get_index();
+    save_info();
 }
 
 void SearchNode::close() {
     assert(info.status == SearchNodeInfo::OPEN);
     info.status = SearchNodeInfo::CLOSED;
+    save_info();
 }
 
 void SearchNode::mark_as_dead_end() {
     info.status = SearchNodeInfo::DEAD_END;
+    save_info();
 }
 
 void SearchNode::dump() const {
@@ -114,14 +132,79 @@ void SearchNode::dump() const {
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type)
+SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                         bool compact)
     : state_registry(state_registry),
-      cost_type(cost_type) {
+      cost_type(cost_type),
+      compact(compact),
+      store_real_g(true),
+      real_gs(-1),
+      creating_operators(compute_bits_for_range(
+                             state_registry.get_search_task().num_operators() + 1)) {
+    if (compact) {
+        // g and real_g coincide if the cost type does not change any cost.
+        const task_representation::SearchTask &task = state_registry.get_search_task();
+        store_real_g = false;
+        for (int op = 0; op < task.num_operators(); ++op) {
+            int cost = task.get_operator_cost(OperatorID(op));
+            if (get_adjusted_action_cost(cost, cost_type) != cost) {
+                store_real_g = true;
+                break;
+            }
+        }
+    }
+}
+
+SearchNodeInfo SearchSpace::get_info(const GlobalState &state) const {
+    if (!compact) {
+        return search_node_infos[state];
+    }
+    const CompactSearchNodeInfo &compact_info = compact_search_node_infos[state];
+    SearchNodeInfo info;
+    info.status = compact_info.status;
+    info.g = compact_info.g;
+    info.parent_state_id = compact_info.parent_state_id;
+    size_t id = state.get_id().value;
+    if (id < creating_operators.size()) {
+        info.creating_operator = static_cast<int>(creating_operators.get(id)) - 1;
+    }
+    info.real_g = store_real_g ? real_gs[state] : compact_info.g;
+    return info;
+}
+
+void SearchSpace::set_info(StateID state_id, const SearchNodeInfo &info) {
+    GlobalState state = state_registry.lookup_state(state_id);
+    if (!compact) {
+        search_node_infos[state] = info;
+        return;
+    }
+    CompactSearchNodeInfo &compact_info = compact_search_node_infos[state];
+    compact_info.status = info.status;
+    compact_info.g = info.g;
+    compact_info.parent_state_id = info.parent_state_id;
+    size_t id = state_id.value;
+    if (creating_operators.size() <= id) {
+        creating_operators.resize(state_registry.size());
+    }
+    creating_operators.set(id, info.creating_operator + 1);
+    if (store_real_g) {
+        real_gs[state] = info.real_g;
+    } else {
+        assert(info.real_g == info.g);
+    }
+}
+
+double SearchSpace::get_node_info_bytes_per_state() const {
+    if (!compact) {
+        return sizeof(SearchNodeInfo);
+    }
+    return sizeof(CompactSearchNodeInfo) +
+           (store_real_g ? sizeof(int) : 0) +
+           creating_operators.get_bits_per_entry() / 8.0;
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
-    return SearchNode(
-        state_registry, state.get_id(), search_node_infos[state], cost_type);
+    return SearchNode(*this, state.get_id(), get_info(state), cost_type);
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
@@ -132,7 +215,7 @@ void SearchSpace::trace_path(const GlobalState &goal_state,
     states.push_back(goal_state);
     assert(plan.empty());
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[states.back()];
+        SearchNodeInfo info = get_info(states.back());
         if (info.creating_operator == -1) {
             assert(info.parent_state_id == StateID::no_state);
             break;
@@ -188,7 +271,7 @@ void SearchSpace::set_path(const PlanState &state, Plan& _plan, const std::vecto
 void SearchSpace::dump() const {
     for (StateID id : state_registry) {
         GlobalState state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
+        SearchNodeInfo node_info = get_info(state);
         cout << id << ": ";
         state.dump_fdr();
         if (node_info.creating_operator != -1 &&
@@ -204,4 +287,9 @@ void SearchSpace::dump() const {
 void SearchSpace::print_statistics() const {
     cout << "Number of registered states: "
          << state_registry.size() << endl;
+    double node_info_bytes = get_node_info_bytes_per_state();
+    cout << "Search node info bytes per state: " << node_info_bytes << endl;
+    cout << "Bytes per state (packed state and search node info): "
+         << state_registry.get_state_size_in_bytes() + node_info_bytes << endl;
+    state_registry.print_statistics();
 }
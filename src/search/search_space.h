@@ -6,20 +6,30 @@
 #include "per_state_information.h"
 #include "search_node_info.h"
 
+#include "algorithms/packed_int_vector.h"
+
 #include <vector>
 
 class GlobalState;
 class Plan;
+class SearchSpace;
 
+/*
+  A SearchNode holds a copy of the SearchNodeInfo of its state, and all
+  modifying methods write it back to the SearchSpace. This allows the
+  SearchSpace to store the information in a compact form.
+*/
 class SearchNode {
-    const StateRegistry &state_registry;
+    SearchSpace &search_space;
     StateID state_id;
-    SearchNodeInfo &info;
+    SearchNodeInfo info;
     OperatorCost cost_type;
+
+    void save_info();
 public:
-    SearchNode(const StateRegistry &state_registry,
+    SearchNode(SearchSpace &search_space,
                StateID state_id,
-               SearchNodeInfo &info,
+               const SearchNodeInfo &info,
                OperatorCost cost_type);
 
     StateID get_state_id() const {
@@ -47,12 +57,42 @@ public:
 
 
 class SearchSpace {
+    friend class SearchNode;
+
     PerStateInformation<SearchNodeInfo> search_node_infos;
 
+    /*
+      In compact mode, search_node_infos is unused. Instead, status, g and
+      parent are stored in compact_search_node_infos, the creating operators
+      are bit-packed (shifted by one to represent "no operator" as 0) and
+      real_g is only stored if it can differ from g under the cost type.
+      g has 30 bits as in SearchNodeInfo, so compact mode supports the same
+      range of g values as regular search nodes.
+    */
+    struct CompactSearchNodeInfo {
+        unsigned int status : 2;
+        int g : 30;
+        StateID parent_state_id;
+
+        CompactSearchNodeInfo()
+            : status(SearchNodeInfo::NEW), g(-1),
+              parent_state_id(StateID::no_state) {
+        }
+    };
+
     StateRegistry &state_registry;
     OperatorCost cost_type;
+    const bool compact;
+    bool store_real_g;
+    PerStateInformation<CompactSearchNodeInfo> compact_search_node_infos;
+    PerStateInformation<int> real_gs;
+    packed_int_vector::PackedIntVector creating_operators;
+
+    SearchNodeInfo get_info(const GlobalState &state) const;
+    void set_info(StateID state_id, const SearchNodeInfo &info);
 public:
-    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type);
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                bool compact = false);
 
     SearchNode get_node(const GlobalState &state);
     void trace_path(const GlobalState &goal_state, Plan &path) const;
@@ -61,6 +101,7 @@ public:
 
     void dump() const;
 
+    double get_node_info_bytes_per_state() const;
     void print_statistics() const;
 };
 
@@ -6,8 +6,14 @@
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+namespace hda_star_search {
+class HDAStarSearch;
+}
+
 class StateID {
+    friend class SearchSpace;
     friend class StateRegistry;
+    friend class hda_star_search::HDAStarSearch;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
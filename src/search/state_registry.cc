@@ -12,7 +12,6 @@ StateRegistry::StateRegistry(
       num_variables(task->num_variables()),
       state_data_pool(get_bins_per_state()),
       registered_states(
-          0,
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
       cached_initial_state(0) {
@@ -34,14 +33,14 @@ StateID StateRegistry::insert_id_or_pop_state() {
       is present), we have to remove the duplicate entry from the
       state data pool.
     */
-    StateID id(state_data_pool.size() - 1);
-    pair<StateIDSet::iterator, bool> result = registered_states.insert(id);
+    int id = state_data_pool.size() - 1;
+    pair<int, bool> result = registered_states.insert(id);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
         state_data_pool.pop_back();
     }
-    assert(registered_states.size() == state_data_pool.size());
-    return *result.first;
+    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+    return StateID(result.first);
 }
 
 GlobalState StateRegistry::lookup_state(StateID id) const {
@@ -89,7 +88,13 @@ GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor,
     //assert(!op.is_axiom());
     state_data_pool.push_back(predecessor.get_packed_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
-    task->apply_operator(predecessor, op, buffer);
+    task->apply_operator(op, buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+GlobalState StateRegistry::register_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
@@ -102,6 +107,10 @@ int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
+void StateRegistry::print_statistics() const {
+    registered_states.print_statistics();
+}
+
 void StateRegistry::subscribe(PerStateInformationBase *psi) const {
     subscribers.insert(psi);
 }
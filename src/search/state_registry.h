@@ -5,6 +5,7 @@
 #include "operator_id.h"
 #include "state_id.h"
 
+#include "algorithms/int_hash_set.h"
 #include "algorithms/int_packer.h"
 #include "algorithms/segmented_vector.h"
 
@@ -13,7 +14,6 @@
 #include "utils/hash.h"
 
 #include <set>
-#include <unordered_set>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -118,8 +118,8 @@ class StateRegistry {
               state_size(state_size) {
         }
 
-        size_t operator()(StateID id) const {
-            const PackedStateBin *data = state_data_pool[id.value];
+        size_t operator()(int id) const {
+            const PackedStateBin *data = state_data_pool[id];
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
@@ -138,9 +138,9 @@ class StateRegistry {
               state_size(state_size) {
         }
 
-        bool operator()(StateID lhs, StateID rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs.value];
-            const PackedStateBin *rhs_data = state_data_pool[rhs.value];
+        bool operator()(int lhs, int rhs) const {
+            const PackedStateBin *lhs_data = state_data_pool[lhs];
+            const PackedStateBin *rhs_data = state_data_pool[rhs];
             return std::equal(lhs_data, lhs_data + state_size, rhs_data);
         }
     };
@@ -148,9 +148,10 @@ class StateRegistry {
     /*
       Hash set of StateIDs used to detect states that are already registered in
       this registry and find their IDs. States are compared/hashed semantically,
-      i.e. the actual state data is compared, not the memory location.
+      i.e. the actual state data is compared, not the memory location. The set
+      uses open addressing and stores the IDs as ints, see IntHashSet.
     */
-    using StateIDSet = std::unordered_set<StateID, StateIDSemanticHash, StateIDSemanticEqual>;
+    using StateIDSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
 
     /* TODO: The state registry still doesn't use the task interface completely.
              Fixing this is part of issue509. */
@@ -174,6 +175,14 @@ public:
         return num_variables;
     }
 
+    const task_representation::SearchTask &get_search_task() const {
+        return *task;
+    }
+
+    const int_packer::IntPacker &get_state_packer() const {
+        return *state_packer;
+    }
+
     int get_state_value(const PackedStateBin *buffer, int var) const {
         return state_packer->get(buffer, var);
     }
@@ -198,6 +207,13 @@ public:
     //GlobalState get_successor_state(const GlobalState &predecessor, const task_representation::SASOperator &op);
     GlobalState get_successor_state(const GlobalState &predecessor, OperatorID op);
 
+    /*
+      Returns the state with the given packed state data and registers it
+      if this was not done before. The buffer must have been created with
+      the state packer of this registry.
+    */
+    GlobalState register_state(const PackedStateBin *buffer);
+
     /*
       Returns the number of states registered so far.
     */
@@ -207,6 +223,8 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    void print_statistics() const;
+
     /*
       Remembers the given PerStateInformation. If this StateRegistry is
       destroyed, it notifies all subscribed PerStateInformation objects.
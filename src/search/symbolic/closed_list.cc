@@ -19,7 +19,8 @@ using namespace std;
 
 namespace symbolic {
     ClosedList::ClosedList(const std::shared_ptr<task_representation::FTSTask> &_task) : OppositeFrontier(_task),
-                                                                                         mgr(nullptr), task(_task) {}
+                                                                                         mgr(nullptr), task(_task),
+                                                                                         record_insertions(false) {}
 
     void ClosedList::init(SymStateSpaceManager *manager, UnidirectionalSearch *search) {
         mgr = manager;
@@ -75,6 +76,9 @@ namespace symbolic {
             zeroCostClosed[h].push_back(S);
         }
         closedTotal += S;
+        if (record_insertions) {
+            insertions.emplace_back(h, S);
+        }
 
         //Introduce in closedUpTo
         auto c = closedUpTo.lower_bound(h);
@@ -453,6 +457,12 @@ namespace symbolic {
 
 
     void ClosedList::statistics() const {
+        long layer_nodes = 0;
+        for (const auto &layer : closed) {
+            layer_nodes += layer.second.nodeCount();
+        }
+        cout << "closed: " << closed.size() << " layers with " << layer_nodes
+             << " nodes (total " << closedTotal.nodeCount() << " nodes)";
         // cout << "h (eval " << num_calls_eval << ", not_closed" << time_eval_states << "s, closed " << time_closed_states
         //   << "s, pruned " << time_pruned_states << "s, some " << time_prune_some
         //   << "s, all " << time_prune_all  << ", children " << time_prune_some_children << "s)";
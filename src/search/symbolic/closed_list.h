@@ -8,6 +8,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <utility>
 
 namespace symbolic {
 
@@ -35,6 +36,11 @@ private:
     std::map<int, BDD> closedUpTo;  // Disjunction of BDDs in closed  (auxiliar useful to take the maximum between several BDDs)
     std::set<int> h_values; //Set of h_values of the heuristic
 
+    // Insertions not yet taken with takeInsertions(). Only recorded after
+    // startRecordingInsertions(), to mirror the list in another CUDD manager
+    bool record_insertions;
+    std::vector<std::pair<int, BDD>> insertions;
+
     void newHValue(int h_value); 
 
 public:
@@ -44,6 +50,18 @@ public:
     void init(SymStateSpaceManager *manager, UnidirectionalSearch * search, const ClosedList &other);
 
     void insert(int h, const BDD &S);
+
+    inline void startRecordingInsertions() {
+        record_insertions = true;
+    }
+
+    //Returns the insertions since the last call, in insertion order
+    std::vector<std::pair<int, BDD>> takeInsertions() {
+        std::vector<std::pair<int, BDD>> result;
+        result.swap(insertions);
+        return result;
+    }
+
     void setHNotClosed(int h);
     void setFNotClosed(int f);
     
@@ -1,10 +1,28 @@
 #include "original_state_space.h"
 #include <algorithm>
 #include "../task_representation/labels.h"
+#include "../task_representation/transition_system.h"
+#include "../utils/timer.h"
 
 using namespace std;
 
 namespace symbolic {
+/*
+  A factor can only be left out of the TR of a label if the label is a
+  self-loop on every state and has no other transitions. After label
+  reduction, a label group can have a self-loop on every state plus
+  further transitions, which TransitionSystem::is_selfloop_everywhere
+  does not exclude.
+*/
+static bool is_identity(const task_representation::TransitionSystem &ts,
+                        task_representation::LabelID label_id) {
+    if (!ts.is_selfloop_everywhere(label_id))
+        return false;
+    int group_id = ts.get_label_group_id_of_label(label_id);
+    return static_cast<int>(ts.get_transitions_for_group_id(group_id).size()) ==
+           ts.get_size();
+}
+
 OriginalStateSpace::OriginalStateSpace(SymVariables *v,
                                        const SymParamsMgr &params, const shared_ptr<task_representation::FTSTask> &_task) :
     SymStateSpaceManager(v, params, _task), task(_task) {
@@ -14,19 +32,95 @@ OriginalStateSpace::OriginalStateSpace(SymVariables *v,
 
 //    init_mutex(g_mutex_groups);
 
+    vars->enable_dynamic_reordering();
+    utils::Timer tr_timer;
+    int num_factors = task->get_size();
+    // BDD of the transitions of each label group of each factor, computed on demand
+    vector<map<int, BDD>> group_bdds(num_factors);
+
+    // Labels with the same cost and the same label group in every factor
+    // where they are not an identity have identical TRs. We map the cost
+    // and, for each factor, whether the label is an identity and its label
+    // group to the position of the TR in indTRs[cost].
+    map<pair<int, vector<pair<bool, int>>>, size_t> tr_by_groups;
+    pair<int, vector<pair<bool, int>>> key;
+    int num_distinct_trs = 0;
+    long distinct_tr_nodes = 0;
     for (int l = 0; l < task->get_labels().get_size(); ++l) {
 //        DEBUG_MSG(cout << "Creating TR of label " << l << " of cost "  << endl;
 //	    );
         int cost = task->get_label_cost(l);
+        task_representation::LabelID label_id(l);
+
+        key.first = cost;
+        key.second.clear();
+        for (int i = 0; i < num_factors; ++i) {
+            const task_representation::TransitionSystem &ts = task->get_ts(i);
+            if (is_identity(ts, label_id)) {
+                key.second.emplace_back(true, 0);
+            } else {
+                key.second.emplace_back(
+                    false, ts.get_label_group_id_of_label(label_id));
+            }
+        }
 
-        indTRs[cost].push_back(TransitionRelation(vars, l, task));
+        vector<TransitionRelation> &trs = indTRs[cost];
+        auto it = tr_by_groups.find(key);
+        if (it != tr_by_groups.end()) {
+            trs.push_back(TransitionRelation(trs[it->second], l));
+            continue;
+        }
+
+        vector<int> effVars;
+        vector<BDD> factorBDDs;
+        BDD tBDD = vars->oneBDD();
+        for (int i = 0; i < num_factors; ++i) {
+            if (key.second[i].first) {
+                continue;
+            }
+            int group_id = key.second[i].second;
+            auto group_it = group_bdds[i].find(group_id);
+            if (group_it == group_bdds[i].end()) {
+                BDD group_bdd = vars->zeroBDD();
+                const task_representation::TransitionSystem &ts = task->get_ts(i);
+                for (const auto &transition : ts.get_transitions_for_group_id(group_id)) {
+                    group_bdd += vars->sourceStateBDD(i, transition.src) * vars->targetStateBDD(i, transition.target);
+                }
+                group_it = group_bdds[i].emplace(group_id, group_bdd).first;
+            }
+            effVars.push_back(i);
+            factorBDDs.push_back(group_it->second);
+            tBDD *= group_it->second;
+        }
+
+        tr_by_groups[key] = trs.size();
+        trs.push_back(TransitionRelation(vars, l, tBDD, effVars, task));
+        if (p.image_type == ImageType::PARTITIONED) {
+            trs.back().partition(factorBDDs, p.max_cluster_size);
+        }
+        ++num_distinct_trs;
+        distinct_tr_nodes += tBDD.nodeCount();
 //        if (p.mutex_type == MutexType::MUTEX_EDELETION) {
 //            indTRs[cost].back().edeletion(notMutexBDDsByFluentFw, notMutexBDDsByFluentBw, exactlyOneBDDsByFluent);
 //        }
     }
+    cout << "Individual TRs: " << task->get_labels().get_size() << " labels, "
+         << num_distinct_trs << " distinct TRs with " << distinct_tr_nodes
+         << " nodes, time: " << tr_timer << endl;
 
-
+    utils::Timer merge_timer;
     init_transitions(indTRs);
+    int num_merged_trs = 0;
+    long merged_tr_nodes = 0;
+    for (const auto &cost_trs : transitions) {
+        for (const TransitionRelation &tr : cost_trs.second) {
+            ++num_merged_trs;
+            merged_tr_nodes += tr.nodeCount();
+        }
+    }
+    cout << "Merged TRs: " << num_merged_trs << " TRs with " << merged_tr_nodes
+         << " nodes, time: " << merge_timer << endl;
+    vars->disable_dynamic_reordering();
 }
 
 //void OriginalStateSpace::init_mutex(const std::vector<MutexGroup> &mutex_groups) {
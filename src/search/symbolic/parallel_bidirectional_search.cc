@@ -0,0 +1,170 @@
+#include "parallel_bidirectional_search.h"
+
+#include "closed_list.h"
+#include "sym_controller.h"
+#include "sym_solution.h"
+#include "sym_variables.h"
+#include "uniform_cost_search.h"
+
+#include "../utils/countdown_timer.h"
+
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace symbolic {
+ParallelBidirectionalSearch::Direction::Direction(
+    bool fw, const shared_ptr<SymVariables> &vars,
+    unique_ptr<UniformCostSearch> search,
+    unique_ptr<UniformCostSearch> opposite)
+    : fw(fw),
+      vars(vars),
+      search(move(search)),
+      opposite(move(opposite)),
+      inbox_h_not_closed(0),
+      inbox_f_not_closed(0),
+      inbox_g(0),
+      opposite_g(0),
+      num_received_layers(0) {
+}
+
+ParallelBidirectionalSearch::ParallelBidirectionalSearch(
+    SymController *eng, const SymParamsSearch &params,
+    const shared_ptr<SymVariables> &fw_vars,
+    unique_ptr<UniformCostSearch> fw_search,
+    unique_ptr<UniformCostSearch> fw_opposite,
+    const shared_ptr<SymVariables> &bw_vars,
+    unique_ptr<UniformCostSearch> bw_search,
+    unique_ptr<UniformCostSearch> bw_opposite,
+    double max_time)
+    : SymSearch(eng, params),
+      exchange_mgr(make_unique<Cudd>(fw_vars->mgr()->ReadSize(), 0)),
+      fw(make_unique<Direction>(true, fw_vars, move(fw_search), move(fw_opposite))),
+      bw(make_unique<Direction>(false, bw_vars, move(bw_search), move(bw_opposite))),
+      max_time(max_time) {
+    assert(fw_vars != bw_vars);
+    assert(fw->search->getStateSpace() == fw->opposite->getStateSpace());
+    assert(bw->search->getStateSpace() == bw->opposite->getStateSpace());
+    mgr = fw->search->getStateSpaceShared();
+    // The initial layers are already known by the mirrors
+    fw->search->getClosedShared()->startRecordingInsertions();
+    bw->search->getClosedShared()->startRecordingInsertions();
+}
+
+void ParallelBidirectionalSearch::send(Direction &from, Direction &to) {
+    shared_ptr<ClosedList> closed = from.search->getClosedShared();
+    vector<pair<int, BDD>> layers = closed->takeInsertions();
+    int g = from.search->getG();
+
+    lock_guard<mutex> lock(exchange_mutex);
+    for (const auto &layer : layers) {
+        to.inbox.emplace_back(layer.first, layer.second.Transfer(*exchange_mgr));
+    }
+    to.inbox_h_not_closed = closed->getHNotClosed();
+    to.inbox_f_not_closed = closed->getFNotClosed();
+    to.inbox_g = g;
+}
+
+void ParallelBidirectionalSearch::receive(Direction &dir) {
+    vector<pair<int, BDD>> layers;
+    int h_not_closed, f_not_closed, g;
+    {
+        lock_guard<mutex> lock(exchange_mutex);
+        for (const auto &layer : dir.inbox) {
+            layers.emplace_back(layer.first, layer.second.Transfer(*dir.vars->mgr()));
+        }
+        dir.inbox.clear();
+        h_not_closed = dir.inbox_h_not_closed;
+        f_not_closed = dir.inbox_f_not_closed;
+        g = dir.inbox_g;
+    }
+
+    shared_ptr<ClosedList> closed = dir.search->getClosedShared();
+    shared_ptr<ClosedList> mirror = dir.opposite->getClosedShared();
+    for (const auto &layer : layers) {
+        SymSolution sol = closed->checkCut(dir.opposite.get(), layer.second,
+                                           layer.first, !dir.fw);
+        if (sol.solved()) {
+            cout << "Solution found with cost " << sol.getCost()
+                 << " total time: " << utils::g_timer << endl;
+            engine->new_solution(sol);
+        }
+        mirror->insert(layer.first, layer.second);
+    }
+    mirror->setHNotClosed(h_not_closed);
+    mirror->setFNotClosed(f_not_closed);
+    dir.num_received_layers += layers.size();
+    dir.opposite_g = g;
+}
+
+void ParallelBidirectionalSearch::run(
+    Direction &dir, Direction &other,
+    const utils::WallClockCountdownTimer &timer) {
+    while (!timer.is_expired()) {
+        receive(dir);
+        engine->setLowerBound(getExchangedF());
+        if (engine->solved()) {
+            break;
+        }
+        dir.search->step();
+        dir.vars->reorder_if_grown();
+        send(dir, other);
+    }
+}
+
+int ParallelBidirectionalSearch::getExchangedF() const {
+    int g_fw = bw->opposite_g;
+    int g_bw = fw->opposite_g;
+    if (g_fw == numeric_limits<int>::max() || g_bw == numeric_limits<int>::max()) {
+        return numeric_limits<int>::max();
+    }
+    return g_fw + g_bw + mgr->getAbsoluteMinTransitionCost();
+}
+
+bool ParallelBidirectionalSearch::stepImage(int, int) {
+    // CPU time would count both threads
+    utils::WallClockCountdownTimer timer(max_time);
+    thread bw_thread([this, &timer]() {run(*bw, *fw, timer);});
+    run(*fw, *bw, timer);
+    bw_thread.join();
+
+    engine->setLowerBound(getF());
+    return true;
+}
+
+int ParallelBidirectionalSearch::getF() const {
+    return max(max(fw->search->getF(), bw->search->getF()), getExchangedF());
+}
+
+bool ParallelBidirectionalSearch::finished() const {
+    return fw->search->finished() || bw->search->finished();
+}
+
+void ParallelBidirectionalSearch::statistics() const {
+    fw->search->statistics();
+    bw->search->statistics();
+    cout << "Received layers: " << fw->num_received_layers << " fw, "
+         << bw->num_received_layers << " bw" << endl;
+    cout << "Backward BDD nodes: " << bw->vars->totalNodes() << endl;
+    cout << endl;
+}
+
+bool ParallelBidirectionalSearch::isSearchableWithNodes(int maxNodes) const {
+    return fw->search->isSearchableWithNodes(maxNodes) ||
+           bw->search->isSearchableWithNodes(maxNodes);
+}
+
+long ParallelBidirectionalSearch::nextStepTime() const {
+    return min(fw->search->nextStepTime(), bw->search->nextStepTime());
+}
+
+long ParallelBidirectionalSearch::nextStepNodes() const {
+    return min(fw->search->nextStepNodes(), bw->search->nextStepNodes());
+}
+
+long ParallelBidirectionalSearch::nextStepNodesResult() const {
+    return min(fw->search->nextStepNodesResult(), bw->search->nextStepNodesResult());
+}
+}
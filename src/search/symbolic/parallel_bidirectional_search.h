@@ -0,0 +1,104 @@
+#ifndef SYMBOLIC_PARALLEL_BIDIRECTIONAL_SEARCH_H
+#define SYMBOLIC_PARALLEL_BIDIRECTIONAL_SEARCH_H
+
+#include "sym_search.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace utils {
+class WallClockCountdownTimer;
+}
+
+namespace symbolic {
+class SymVariables;
+class UniformCostSearch;
+
+/*
+ * Bidirectional uniform cost search that runs the forward and the backward
+ * search in two threads.
+ *
+ * Each direction owns a CUDD manager (with the same initial variable order)
+ * and all BDDs in it, so managers are never accessed by two threads. Besides
+ * its own search, each direction keeps a mirror of the closed list of the
+ * opposite direction in its manager, which is used for the cut checks and to
+ * reconstruct the opposite part of the plan. Newly closed layers are sent to
+ * the other direction through a third CUDD manager guarded by a mutex, using
+ * Cudd_bddTransfer.
+ *
+ * Every received layer is checked against the own closed list, so a meeting
+ * of both searches is detected even if the opposite layer arrives after the
+ * own states have been closed. For the same reason, the lower bound
+ * g_fw + g_bw only uses the g values that the other direction has already
+ * received. Bounds and solutions are shared through the SymController.
+ */
+class ParallelBidirectionalSearch : public SymSearch {
+    struct Direction {
+        bool fw;
+        std::shared_ptr<SymVariables> vars;
+        std::unique_ptr<UniformCostSearch> search;
+        // Mirror of the closed list of the opposite direction
+        std::unique_ptr<UniformCostSearch> opposite;
+
+        // Layers sent by the opposite direction (in the exchange manager)
+        // and its bounds when sending them. Guarded by exchange_mutex.
+        std::vector<std::pair<int, BDD>> inbox;
+        int inbox_h_not_closed, inbox_f_not_closed, inbox_g;
+
+        // g of the opposite direction whose layers have been received
+        std::atomic<int> opposite_g;
+        int num_received_layers;
+
+        Direction(bool fw, const std::shared_ptr<SymVariables> &vars,
+                  std::unique_ptr<UniformCostSearch> search,
+                  std::unique_ptr<UniformCostSearch> opposite);
+    };
+
+    // Declared before the directions, which hold BDDs of this manager
+    std::unique_ptr<Cudd> exchange_mgr;
+    std::mutex exchange_mutex;
+    std::unique_ptr<Direction> fw, bw;
+    const double max_time;
+
+    void send(Direction &from, Direction &to);
+    void receive(Direction &dir);
+    void run(Direction &dir, Direction &other,
+             const utils::WallClockCountdownTimer &timer);
+
+    // Lower bound given by the g values exchanged between the directions
+    int getExchangedF() const;
+
+public:
+    /*
+     * search and opposite of each direction must be initialized with the
+     * state space of vars, and search must use the closed list of opposite
+     * as perfect heuristic.
+     */
+    ParallelBidirectionalSearch(SymController *eng, const SymParamsSearch &params,
+                                const std::shared_ptr<SymVariables> &fw_vars,
+                                std::unique_ptr<UniformCostSearch> fw_search,
+                                std::unique_ptr<UniformCostSearch> fw_opposite,
+                                const std::shared_ptr<SymVariables> &bw_vars,
+                                std::unique_ptr<UniformCostSearch> bw_search,
+                                std::unique_ptr<UniformCostSearch> bw_opposite,
+                                double max_time);
+    virtual ~ParallelBidirectionalSearch() override = default;
+
+    // Runs both directions until the search is solved or out of time
+    virtual bool stepImage(int maxTime, int maxNodes) override;
+
+    virtual int getF() const override;
+    virtual bool finished() const override;
+
+    virtual void statistics() const override;
+
+    virtual bool isSearchableWithNodes(int maxNodes) const override;
+    virtual long nextStepTime() const override;
+    virtual long nextStepNodes() const override;
+    virtual long nextStepNodesResult() const override;
+};
+}
+#endif
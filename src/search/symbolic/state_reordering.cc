@@ -9,6 +9,8 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include <algorithm>
+
 using namespace std;
 using options::Options;
 
@@ -58,6 +60,123 @@ namespace symbolic {
         }
     }
 
+    /*
+      Returns the codes of the states of a factor such that the i-th state
+      of states_in_order gets the i-th code (in binary or Gray code).
+    */
+    static vector<int> assign_codes(const vector<int> &states_in_order, bool gray_code) {
+        vector<int> codes(states_in_order.size());
+        for (size_t i = 0; i < states_in_order.size(); ++i) {
+            int code = static_cast<int>(i);
+            if (gray_code) {
+                code ^= code >> 1;
+            }
+            codes[states_in_order[i]] = code;
+        }
+        return codes;
+    }
+
+    static vector<vector<int>> compute_adjacency(const task_representation::TransitionSystem &ts,
+                                                 bool backward, bool undirected) {
+        vector<vector<int>> adjacency(ts.get_size());
+        for (const auto &group_and_transitions : ts) {
+            for (const auto &transition : group_and_transitions.transitions) {
+                if (transition.src == transition.target) {
+                    continue;
+                }
+                if (backward) {
+                    adjacency[transition.target].push_back(transition.src);
+                } else {
+                    adjacency[transition.src].push_back(transition.target);
+                }
+                if (undirected) {
+                    adjacency[transition.target].push_back(transition.src);
+                }
+            }
+        }
+        for (vector<int> &successors : adjacency) {
+            sort(successors.begin(), successors.end());
+            successors.erase(unique(successors.begin(), successors.end()), successors.end());
+        }
+        return adjacency;
+    }
+
+    symbolic::GrayCodeStateReordering::GrayCodeStateReordering(const options::Options&) {
+        name = "gray code state reordering";
+    }
+
+    void GrayCodeStateReordering::computeStateReordering(std::vector<int> &var_order,
+                                                         std::map<int, std::vector<int>> &var_to_state,
+                                                         const std::shared_ptr<task_representation::FTSTask> &task) {
+        for (auto var : var_order) {
+            const task_representation::TransitionSystem &ts = task->get_ts(var);
+            int num_states = ts.get_size();
+            vector<vector<int>> adjacency = compute_adjacency(ts, false, true);
+
+            vector<int> bfs_order;
+            bfs_order.reserve(num_states);
+            vector<bool> reached(num_states, false);
+            // Start with the initial state, then with every state not reached yet.
+            for (int i = -1; i < num_states; ++i) {
+                int root = (i == -1) ? ts.get_init_state() : i;
+                if (reached[root]) {
+                    continue;
+                }
+                reached[root] = true;
+                size_t next = bfs_order.size();
+                bfs_order.push_back(root);
+                while (next < bfs_order.size()) {
+                    int state = bfs_order[next++];
+                    for (int succ : adjacency[state]) {
+                        if (!reached[succ]) {
+                            reached[succ] = true;
+                            bfs_order.push_back(succ);
+                        }
+                    }
+                }
+            }
+            var_to_state[var] = assign_codes(bfs_order, true);
+        }
+    }
+
+    symbolic::GoalDistanceStateReordering::GoalDistanceStateReordering(const options::Options& options) :
+            gray_code(options.get<bool>("gray_code")) {
+        name = gray_code ? "goal distance state reordering (gray code)" : "goal distance state reordering";
+    }
+
+    void GoalDistanceStateReordering::computeStateReordering(std::vector<int> &var_order,
+                                                             std::map<int, std::vector<int>> &var_to_state,
+                                                             const std::shared_ptr<task_representation::FTSTask> &task) {
+        for (auto var : var_order) {
+            const task_representation::TransitionSystem &ts = task->get_ts(var);
+            int num_states = ts.get_size();
+            vector<vector<int>> predecessors = compute_adjacency(ts, true, false);
+
+            // Backward breadth-first search from the goal states.
+            vector<int> by_distance;
+            by_distance.reserve(num_states);
+            vector<bool> reached(num_states, false);
+            for (int goal : ts.get_goal_states()) {
+                reached[goal] = true;
+                by_distance.push_back(goal);
+            }
+            for (size_t next = 0; next < by_distance.size(); ++next) {
+                for (int pred : predecessors[by_distance[next]]) {
+                    if (!reached[pred]) {
+                        reached[pred] = true;
+                        by_distance.push_back(pred);
+                    }
+                }
+            }
+            for (int state = 0; state < num_states; ++state) {
+                if (!reached[state]) {
+                    by_distance.push_back(state);
+                }
+            }
+            var_to_state[var] = assign_codes(by_distance, gray_code);
+        }
+    }
+
     // Plugin
     static shared_ptr<DefaultStateReordering> _parse_default(options::OptionParser &parser) {
         parser.document_synopsis(
@@ -93,5 +212,39 @@ namespace symbolic {
 
     static PluginShared<StateReordering> _plugin_random("random", _parse_gamer);
 
+    static shared_ptr<GrayCodeStateReordering> _parse_gray(options::OptionParser &parser) {
+        parser.document_synopsis(
+                "Gray code state reordering",
+                "Assigns Gray codes to the states of each factor in "
+                "breadth-first order of its transition graph.");
+
+        options::Options opts = parser.parse();
+        if (parser.dry_run()) {
+            return nullptr;
+        }
+
+        return std::make_shared<GrayCodeStateReordering>(opts);
+    }
+
+    static PluginShared<StateReordering> _plugin_gray("gray", _parse_gray);
+
+    static shared_ptr<GoalDistanceStateReordering> _parse_goal_distance(options::OptionParser &parser) {
+        parser.document_synopsis(
+                "Goal distance state reordering",
+                "Assigns consecutive codes to the states of each factor "
+                "ordered by their goal distance in the factor.");
+
+        parser.add_option<bool>("gray_code", "use Gray codes instead of plain binary codes", "true");
+
+        options::Options opts = parser.parse();
+        if (parser.dry_run()) {
+            return nullptr;
+        }
+
+        return std::make_shared<GoalDistanceStateReordering>(opts);
+    }
+
+    static PluginShared<StateReordering> _plugin_goal_distance("goal_distance", _parse_goal_distance);
+
     static PluginTypePlugin<StateReordering> _type_plugin("state_reordering", "This describes the strategy for computing state ordering for the BDD construction. ");
 }
\ No newline at end of file
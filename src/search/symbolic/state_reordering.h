@@ -42,5 +42,45 @@ namespace symbolic {
                                     const std::shared_ptr<task_representation::FTSTask>& _task) override;
         virtual ~RandomStateReordering() = default;
     };
+
+    /*
+      Assigns the i-th code of the binary reflected Gray code to the i-th
+      state of a breadth-first traversal of the (undirected) transition
+      graph of the factor, starting from the initial state. States that
+      are close in the transition graph therefore get codes that differ
+      in few bits. Only the first ts.size() codes are used. Unlike with the
+      binary encoding, they are in general not the smallest numbers (for
+      three states, the codes are 0, 1 and 3), so the unused codes can lie
+      between used ones. This is fine because SymVariables builds the
+      valid values of a variable as the disjunction of the codes of its
+      states.
+    */
+    class GrayCodeStateReordering : public StateReordering {
+    public:
+        explicit GrayCodeStateReordering(const options::Options&);
+        virtual ~GrayCodeStateReordering() = default;
+
+        void computeStateReordering(std::vector<int>& var_order,
+                                    std::map<int, std::vector<int>>& var_to_state,
+                                    const std::shared_ptr<task_representation::FTSTask>& _task) override;
+    };
+
+    /*
+      Orders the states of each factor by their goal distance in the
+      factor (number of transitions, unreachable states last) and assigns
+      consecutive codes in this order, so that states with similar goal
+      distance get nearby codes.
+    */
+    class GoalDistanceStateReordering : public StateReordering {
+    private:
+        bool gray_code;
+    public:
+        explicit GoalDistanceStateReordering(const options::Options&);
+        virtual ~GoalDistanceStateReordering() = default;
+
+        void computeStateReordering(std::vector<int>& var_order,
+                                    std::map<int, std::vector<int>>& var_to_state,
+                                    const std::shared_ptr<task_representation::FTSTask>& _task) override;
+    };
 }
 #endif //FAST_DOWNWARD_STATE_REORDERING_H
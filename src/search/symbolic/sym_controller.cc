@@ -9,9 +9,11 @@
 using namespace std;
 
 namespace symbolic {
-SymController::SymController(const Options &opts, const shared_ptr<task_representation::FTSTask> &_task)
-    : vars(make_shared<SymVariables>(opts, _task)),
-      mgrParams(opts), searchParams(opts), lower_bound(0), solution(_task){
+SymController::SymController(const Options &opts, const shared_ptr<task_representation::FTSTask> &_task,
+                             int num_managers)
+    : vars(make_shared<SymVariables>(opts, _task, num_managers)),
+      mgrParams(opts), searchParams(opts), lower_bound(0),
+      upper_bound(numeric_limits<int>::max()), solution(_task){
     mgrParams.print_options();
     searchParams.print_options();
 
@@ -38,9 +40,11 @@ SymController::SymController(const Options &opts, const shared_ptr<task_represen
 	SymParamsSearch::add_options_to_parser(parser, maxStepTime, maxStepNodes);
     }
     void SymController::new_solution(const SymSolution& sol) {
+	lock_guard<mutex> lock(bounds_mutex);
 	if(!solution.solved() || 
 	   sol.getCost() < solution.getCost()){
 	    solution = sol;
+	    upper_bound = sol.getCost();
 	    std::cout << "BOUND: " << lower_bound << " < " << getUpperBound()
 		      << ", total time: " << utils::g_timer << std::endl;
 
@@ -48,6 +52,7 @@ SymController::SymController(const Options &opts, const shared_ptr<task_represen
     }   
 
     void SymController::setLowerBound(int lower) {
+	lock_guard<mutex> lock(bounds_mutex);
 	//Never set a lower bound greater than the current upper bound
 	if(solution.solved()) {
 	    lower = min(lower,  solution.getCost());
@@ -8,9 +8,11 @@
 #include "sym_params_search.h"
 #include "sym_solution.h"
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <limits>
+#include <mutex>
 
 namespace options {
 class OptionParser;
@@ -30,18 +32,23 @@ protected:
     SymParamsMgr mgrParams; //Parameters for SymStateSpaceManager configuration.
     SymParamsSearch searchParams; //Parameters to search the original state space
 
-    int lower_bound;
+    //The bounds may be read and updated by several threads (e.g. the
+    //directions of a parallel bidirectional search)
+    std::mutex bounds_mutex;
+    std::atomic<int> lower_bound;
+    std::atomic<int> upper_bound;
     SymSolution solution; 
 public:
-    SymController(const options::Options &opts, const std::shared_ptr<task_representation::FTSTask> &task);
+    //num_managers is passed on to SymVariables
+    SymController(const options::Options &opts, const std::shared_ptr<task_representation::FTSTask> &task,
+                  int num_managers = 1);
     virtual ~SymController() = default;
 
     virtual void new_solution(const SymSolution & sol);
     void setLowerBound(int lower);
 
     int getUpperBound() const {
-	if(solution.solved()) return solution.getCost();
-	else return std::numeric_limits<int>::max();
+	return upper_bound;
     }
     int getLowerBound() const {
 	return lower_bound; 
@@ -33,6 +33,32 @@ std::ostream &operator<<(std::ostream &os, const RelaxDirStrategy &relaxDir) {
     }
 }
 
+std::ostream &operator<<(std::ostream &os, const ImageType &type) {
+    switch (type) {
+    case ImageType::MONOLITHIC:
+        return os << "monolithic";
+    case ImageType::PARTITIONED:
+        return os << "partitioned";
+    default:
+        std::cerr << "Name of ImageType not known";
+        utils::exit_with(utils::ExitCode::UNSUPPORTED);
+    }
+}
+
+std::ostream &operator<<(std::ostream &os, const ReorderingType &type) {
+    switch (type) {
+    case ReorderingType::NONE:
+        return os << "none";
+    case ReorderingType::SIFT:
+        return os << "sift";
+    case ReorderingType::GROUP_SIFT:
+        return os << "group_sift";
+    default:
+        std::cerr << "Name of ReorderingType not known";
+        utils::exit_with(utils::ExitCode::UNSUPPORTED);
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const Dir &dir) {
     switch (dir) {
     case Dir::FW:
@@ -144,6 +170,14 @@ const std::vector<std::string> RelaxDirStrategyValues {
     "FW", "BW", "BIDIR", "SWITCHBACK"
 };
 
+const std::vector<std::string> ImageTypeValues {
+    "MONOLITHIC", "PARTITIONED"
+};
+
+const std::vector<std::string> ReorderingTypeValues {
+    "NONE", "SIFT", "GROUP_SIFT"
+};
+
 const std::vector<std::string> DirValues {
     "FW", "BW", "BIDIR"
 };
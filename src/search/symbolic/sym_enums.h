@@ -31,6 +31,17 @@ enum class RelaxDirStrategy {FW, BW, BIDIR, SWITCHBACK};
 std::ostream &operator<<(std::ostream &os, const RelaxDirStrategy &relaxDir);
 extern const std::vector<std::string> RelaxDirStrategyValues;
 
+//Image computation with one relational product per TR or with a
+//conjunctively partitioned TR and early quantification
+enum class ImageType {MONOLITHIC, PARTITIONED};
+std::ostream &operator<<(std::ostream &os, const ImageType &type);
+extern const std::vector<std::string> ImageTypeValues;
+
+//Dynamic reordering of the BDD variables with CUDD
+enum class ReorderingType {NONE, SIFT, GROUP_SIFT};
+std::ostream &operator<<(std::ostream &os, const ReorderingType &type);
+extern const std::vector<std::string> ReorderingTypeValues;
+
 enum class Dir {FW, BW, BIDIR};
 std::ostream &operator<<(std::ostream &os, const Dir &dir);
 extern const std::vector<std::string> DirValues;
@@ -24,6 +24,12 @@ public:
 
     ADD getADD() const;
 
+    //Same cost, but neither cut nor searches (e.g. to keep a solution
+    //whose cut belongs to the CUDD manager of another thread)
+    SymSolution withoutCut() const {
+        return SymSolution(nullptr, nullptr, g, h, BDD(), task);
+    }
+
     inline bool solved() const {
         return g + h >= 0;
     }
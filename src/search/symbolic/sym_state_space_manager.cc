@@ -98,7 +98,7 @@ void SymStateSpaceManager::zero_image(const BDD &bdd, vector <BDD> &res, int nod
 
 void SymStateSpaceManager::cost_preimage(const BDD &bdd, map<int, vector<BDD>> &res,
                                          int nodeLimit) const {
-    for (auto trs : transitions) {
+    for (const auto &trs : transitions) {
         int cost = trs.first;
         if (cost == 0)
             continue;
@@ -112,7 +112,7 @@ void SymStateSpaceManager::cost_preimage(const BDD &bdd, map<int, vector<BDD>> &
 void SymStateSpaceManager::cost_image(const BDD &bdd,
                                       map<int, vector<BDD>> &res,
                                       int nodeLimit) const {
-    for (auto trs : transitions) {
+    for (const auto &trs : transitions) {
         int cost = trs.first;
         if (cost == 0)
             continue;
@@ -227,9 +227,12 @@ void SymStateSpaceManager::init_transitions(const map<int, vector <TransitionRel
 	return;
     }
 
-    for (map<int, vector<TransitionRelation>>::iterator it = transitions.begin();
-         it != transitions.end(); ++it) {
-        merge(vars, it->second, mergeTR, p.max_tr_time, p.max_tr_size);
+    //Merging would discard the partition of the TRs
+    if (p.image_type != ImageType::PARTITIONED) {
+        for (map<int, vector<TransitionRelation>>::iterator it = transitions.begin();
+             it != transitions.end(); ++it) {
+            merge(vars, it->second, mergeTR, p.max_tr_time, p.max_tr_size);
+        }
     }
 
     min_transition_cost = transitions.begin()->first;
@@ -244,6 +247,8 @@ void SymStateSpaceManager::init_transitions(const map<int, vector <TransitionRel
 SymParamsMgr::SymParamsMgr(const options::Options &opts) :
     max_tr_size(opts.get<int>("max_tr_size")),
     max_tr_time(opts.get<int>("max_tr_time")),
+    image_type(ImageType(opts.get_enum("image_type"))),
+    max_cluster_size(opts.get<int>("max_cluster_size")),
     mutex_type(MutexType(opts.get_enum("mutex_type"))),
     max_mutex_size(opts.get<int>("max_mutex_size")),
     max_mutex_time(opts.get<int>("max_mutex_time")),
@@ -261,6 +266,8 @@ SymParamsMgr::SymParamsMgr(const options::Options &opts) :
 SymParamsMgr::SymParamsMgr() :
     max_tr_size(100000),
     max_tr_time(60000),
+    image_type(ImageType::MONOLITHIC),
+    max_cluster_size(10000),
     mutex_type(MutexType::MUTEX_EDELETION),
     max_mutex_size(100000),
     max_mutex_time(60000),
@@ -276,6 +283,7 @@ SymParamsMgr::SymParamsMgr() :
 
 void SymParamsMgr::print_options() const {
     cout << "TR(time=" << max_tr_time << ", nodes=" << max_tr_size << ")" << endl;
+    cout << "Image(type=" << image_type << ", cluster nodes=" << max_cluster_size << ")" << endl;
     cout << "Mutex(time=" << max_mutex_time << ", nodes=" << max_mutex_size << ", type=" << mutex_type << ")" << endl;
     cout << "Aux(time=" << max_aux_time << ", nodes=" << max_aux_nodes << ")" << endl;
 }
@@ -286,6 +294,14 @@ void SymParamsMgr::add_options_to_parser(options::OptionParser &parser) {
     parser.add_option<int> ("max_tr_time",
                             "maximum time (ms) to generate TR BDDs", "60000");
 
+    parser.add_enum_option("image_type", ImageTypeValues,
+                           "image computation: one relational product per TR "
+                           "or conjunctively partitioned TRs with early "
+                           "quantification (TRs are not merged)", "MONOLITHIC");
+
+    parser.add_option<int> ("max_cluster_size",
+                            "maximum size of a cluster of a partitioned TR", "10000");
+
     parser.add_enum_option("mutex_type", MutexTypeValues,
                            "mutex type", "MUTEX_EDELETION");
 
@@ -32,6 +32,10 @@ public:
     //Parameters to generate the TRs
     int max_tr_size, max_tr_time;
 
+    //Parameters of the image computation
+    ImageType image_type;
+    int max_cluster_size;
+
     //Parameters to generate the mutex BDDs
     MutexType mutex_type;
     int max_mutex_size, max_mutex_time;
@@ -1,3 +1,5 @@
+// mtr.h has to be included before cuddObj.hh to declare the group tree API.
+#include "mtr.h"
 #include "sym_variables.h"
 
 #include <iostream>
@@ -13,16 +15,34 @@
 #include "../options/option_parser.h"
 
 
+// Defined in CUDD's util library, whose headers are not on the include path
+extern "C" size_t getSoftDataLimit(void);
+
 using namespace std;
 using options::Options;
 
 namespace symbolic {
-SymVariables::SymVariables(const Options &opts, const shared_ptr<task_representation::FTSTask> &_task) :
+static long get_memory_share(long available_memory, int num_managers) {
+    assert(num_managers >= 1);
+    if (num_managers == 1)
+        return available_memory;
+    //0 lets CUDD use the soft data size limit, which we split as well
+    if (available_memory == 0)
+        available_memory = getSoftDataLimit();
+    return available_memory / num_managers;
+}
+
+SymVariables::SymVariables(const Options &opts, const shared_ptr<task_representation::FTSTask> &_task,
+                           int num_managers) :
         cudd_init_nodes(opts.get<int>("cudd_init_nodes")),
         cudd_init_cache_size(opts.get<int>("cudd_init_cache_size")),
-        cudd_init_available_memory(opts.get<int>("cudd_init_available_memory")),
+        cudd_init_available_memory(get_memory_share(
+            opts.get<int>("cudd_init_available_memory"), num_managers)),
         variable_ordering(opts.get<shared_ptr<VariableOrdering>>("variable_ordering")),
         state_reordering(opts.get<shared_ptr<StateReordering>>("state_reordering")),
+        reordering(ReorderingType(opts.get_enum("reordering"))),
+        reorder_growth(opts.get<double>("reorder_growth")),
+        nodes_after_reordering(0),
         task(_task) {
         cout << "Creating symvariables" << endl;
         print_options();
@@ -37,16 +57,22 @@ void SymVariables::init() {
         cout << v << " ";
     cout << endl;
 
-    map<int, vector<int>> var_to_state = map<int, vector<int>>();
-    state_reordering->computeStateReordering(_var_order, var_to_state, task);
+    map<int, vector<int>> _var_to_state = map<int, vector<int>>();
+    state_reordering->computeStateReordering(_var_order, _var_to_state, task);
+
+    init(_var_order, _var_to_state);
+}
 
-    init(_var_order, var_to_state);
+void SymVariables::init(const SymVariables &other) {
+    assert(task == other.task);
+    init(other.var_order, other.var_to_state);
 }
 
 //Constructor that makes use of global variables to initialize the symbolic_search structures
-void SymVariables::init(const vector <int> &v_order, map<int, vector<int>> var_to_state) {
+void SymVariables::init(const vector <int> &v_order, const map<int, vector<int>> &_var_to_state) {
     cout << "Initializing Symbolic Variables" << endl;
     var_order = vector<int>(v_order);
+    var_to_state = _var_to_state;
     int num_fd_vars = var_order.size();
 
     //Initialize binary representation of variables.
@@ -66,13 +92,19 @@ void SymVariables::init(const vector <int> &v_order, map<int, vector<int>> var_t
     }
     cout << "Num variables: " << var_order.size() << " => " << numBDDVars << endl;
 
-    //Initialize manager
+    //Initialize manager. Each swap of two variables during reordering
+    //scans their whole unique subtables, so with reordering we let the
+    //subtables grow on demand instead of preallocating them.
+    unsigned int num_slots = cudd_init_nodes / _numBDDVars;
+    if (reordering != ReorderingType::NONE) {
+        num_slots = CUDD_UNIQUE_SLOTS;
+    }
     cout << "Initialize Symbolic Manager(" << _numBDDVars << ", "
-         << cudd_init_nodes / _numBDDVars << ", "
+         << num_slots << ", "
          << cudd_init_cache_size << ", "
          << cudd_init_available_memory << ")" << endl;
     _manager = std::make_unique<Cudd> (_numBDDVars, 0,
-                                          cudd_init_nodes / _numBDDVars,
+                                          num_slots,
                                           cudd_init_cache_size,
                                           cudd_init_available_memory);
 
@@ -108,9 +140,75 @@ void SymVariables::init(const vector <int> &v_order, map<int, vector<int>> var_t
     }
 
     binState.resize(_numBDDVars, 0);
+    if (reordering != ReorderingType::NONE) {
+        init_reordering_groups();
+    }
+    nodes_after_reordering = _manager->ReadNodeCount();
     cout << "Symbolic Variables... Done." << endl;
 }
 
+void SymVariables::init_reordering_groups() {
+    //Each variable(FD) is a group that may be reordered internally, but
+    //each pair of source and target bits is fixed.
+    for (int var : var_order) {
+        if (bdd_index_src[var].empty()) {
+            continue;
+        }
+        _manager->MakeTreeNode(bdd_index_src[var][0], 2 * bdd_index_src[var].size(), MTR_DEFAULT);
+        for (int bdd_var : bdd_index_src[var]) {
+            _manager->MakeTreeNode(bdd_var, 2, MTR_FIXED);
+        }
+    }
+}
+
+Cudd_ReorderingType SymVariables::get_reordering_method() const {
+    switch (reordering) {
+    case ReorderingType::SIFT:
+        return CUDD_REORDER_SIFT;
+    case ReorderingType::GROUP_SIFT:
+        return CUDD_REORDER_GROUP_SIFT;
+    default:
+        return CUDD_REORDER_NONE;
+    }
+}
+
+void SymVariables::enable_dynamic_reordering() {
+    if (reordering != ReorderingType::NONE) {
+        _manager->AutodynEnable(get_reordering_method());
+    }
+}
+
+void SymVariables::disable_dynamic_reordering() {
+    if (reordering != ReorderingType::NONE) {
+        _manager->AutodynDisable();
+        nodes_after_reordering = _manager->ReadNodeCount();
+        print_reordering_statistics();
+    }
+}
+
+void SymVariables::reorder_if_grown() {
+    if (reordering == ReorderingType::NONE) {
+        return;
+    }
+    long nodes = _manager->ReadNodeCount();
+    if (nodes < reorder_growth * nodes_after_reordering) {
+        return;
+    }
+    utils::Timer reorder_timer;
+    _manager->ReduceHeap(get_reordering_method());
+    nodes_after_reordering = _manager->ReadNodeCount();
+    cout << "Reordering: " << nodes << " => " << nodes_after_reordering
+         << " nodes, time: " << reorder_timer << endl;
+}
+
+void SymVariables::print_reordering_statistics() const {
+    if (reordering != ReorderingType::NONE) {
+        cout << "Reorderings: " << _manager->ReadReorderings()
+             << ", reordering time: " << _manager->ReadReorderingTime() / 1000.0 << "s"
+             << ", live nodes: " << _manager->ReadNodeCount() << endl;
+    }
+}
+
 BDD SymVariables::getStateBDD(const std::vector<int> &state) const {
     BDD res = _manager->bddOne();
     for (int i = int(var_order.size()) - 1; i >= 0; i--) {
@@ -258,7 +356,8 @@ void SymVariables::print_options() const {
          " cache=" << cudd_init_cache_size <<
          " max_memory=" << cudd_init_available_memory <<
          " variable ordering: " << variable_ordering->name <<
-         " state_reordering: " << state_reordering->name
+         " state_reordering: " << state_reordering->name <<
+         " reordering: " << reordering << " (growth " << reorder_growth << ")"
         << endl;
 }
 
@@ -275,5 +374,13 @@ void SymVariables::add_options_to_parser(options::OptionParser &parser) {
     parser.add_option<shared_ptr<VariableOrdering>> ("variable_ordering", "Use Gamer ordering optimization", "gamer");
 
     parser.add_option<shared_ptr<StateReordering>> ("state_reordering", "Choose state reordering algorithm.", "default");
+
+    parser.add_enum_option("reordering", ReorderingTypeValues,
+                           "dynamic reordering of the BDD variables during TR "
+                           "construction and between search steps", "NONE");
+
+    parser.add_option<double> ("reorder_growth",
+                               "reorder between search steps when the number of live "
+                               "BDD nodes has grown by this factor since the last reordering", "2.0");
 }
 }
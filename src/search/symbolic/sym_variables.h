@@ -7,6 +7,7 @@
 #include "../globals.h"
 #include "../task_representation/fts_task.h"
 #include "state_reordering.h"
+#include "sym_enums.h"
 #include "variable_ordering.h"
 #include <memory>
 #include <iostream>
@@ -27,7 +28,10 @@ namespace symbolic {
 /*
  * BDD-Variables for a symbolic exploration.
  * This information is global for every class using symbolic search.
- * The only decision fixed here is the variable ordering, which is assumed to be always fixed.
+ * The initial variable ordering is fixed here. If dynamic reordering is
+ * enabled, CUDD may change it later; the bits of each variable(FD) form
+ * a group that is moved as a whole, with source and target bits kept
+ * interleaved.
  */
 struct BDDError {};
 extern void exceptionError(std::string message);
@@ -41,6 +45,9 @@ class SymVariables {
     const long cudd_init_available_memory; //Maximum available memory (bytes)
     const std::shared_ptr<VariableOrdering> variable_ordering;
     const std::shared_ptr<StateReordering> state_reordering;
+    const ReorderingType reordering;
+    const double reorder_growth;
+    long nodes_after_reordering;
 
     std::unique_ptr<Cudd> _manager; //_manager associated with this symbolic search
 
@@ -52,6 +59,7 @@ class SymVariables {
 
     //The variable order must be complete.
     std::vector <int> var_order; //Variable(FD) order in the BDD
+    std::map<int, std::vector<int>> var_to_state; //Encoding of the states of each variable(FD)
     std::vector <std::vector <int>> bdd_index_src, bdd_index_target; //vars(BDD) for each var(FD)
 
     // BDDs that use FTSTask
@@ -67,12 +75,30 @@ class SymVariables {
     //Avoid allocating memory during heuristic evaluation
     std::vector <int> binState;
 
-    void init(const std::vector <int> &v_order, std::map<int, std::vector<int>> var_to_state);
+    void init(const std::vector <int> &v_order, const std::map<int, std::vector<int>> &_var_to_state);
+    void init_reordering_groups();
+    Cudd_ReorderingType get_reordering_method() const;
 
 public:
     const std::shared_ptr<task_representation::FTSTask> &task;
-    SymVariables(const options::Options &opts, const std::shared_ptr<task_representation::FTSTask> &_task);
+    //num_managers SymVariables (e.g. one per direction of a parallel
+    //search) share the available memory of the options equally
+    SymVariables(const options::Options &opts, const std::shared_ptr<task_representation::FTSTask> &_task,
+                 int num_managers = 1);
     void init();
+    //Uses the same variable order and state encoding as other, but a CUDD
+    //manager of its own (e.g. for a search running in another thread)
+    void init(const SymVariables &other);
+
+    //Let CUDD reorder automatically (e.g. while constructing TRs)
+    void enable_dynamic_reordering();
+    void disable_dynamic_reordering();
+
+    //Reorders if the number of live nodes has grown by a factor of
+    //reorder_growth since the last reordering (e.g. between search layers)
+    void reorder_if_grown();
+
+    void print_reordering_statistics() const;
 
     BDD getInitialStateBDD() const;
     BDD getGoalBDD() const;
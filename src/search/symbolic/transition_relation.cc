@@ -10,28 +10,25 @@
 using namespace std;
 
 namespace symbolic {
-TransitionRelation::TransitionRelation(SymVariables *sVars,
-                                       const int label, const std::shared_ptr<task_representation::FTSTask> &_task) :
-        sV(sVars), cost(_task->get_label_cost(label)), tBDD(sVars->oneBDD()),
+TransitionRelation::TransitionRelation(SymVariables *sVars, const int label,
+                                       const BDD &tBDD_, const std::vector<int> &effVars_,
+                                       const std::shared_ptr<task_representation::FTSTask> &_task) :
+        sV(sVars), cost(_task->get_label_cost(label)), tBDD(tBDD_), effVars(effVars_),
         existsVars(sVars->oneBDD()), existsBwVars(sVars->oneBDD()),
         absAfterImage(nullptr), task(_task) {
     labels.insert(label);
-
-    for (size_t i = 0; i < size_t(task->get_size()); i++) {
-        task_representation::TransitionSystem ts = task->get_ts(int(i));
-        const std::vector<task_representation::Transition> &transitions = ts.get_transitions_with_label(label);
-
-        BDD BDD_label = sV->zeroBDD();
-        for (auto transition : transitions) {
-            BDD_label += sV->sourceStateBDD(int(i), transition.src) * sV->targetStateBDD(int(i), transition.target);
-        }
-
-        effVars.push_back(i); // TODO Future work: only include a subset of variables
-        tBDD *= BDD_label;
-    }
-
     assert(!tBDD.IsZero());
+    init_swap_vars();
+}
+
+TransitionRelation::TransitionRelation(const TransitionRelation &other, int label) :
+        TransitionRelation(other) {
+    assert(cost == task->get_label_cost(label));
+    labels.clear();
+    labels.insert(label);
+}
 
+void TransitionRelation::init_swap_vars() {
     sort(effVars.begin(), effVars.end());
     for (int var : effVars) {
         for (int bdd_var : sV->vars_index_pre(var)) {
@@ -47,11 +44,67 @@ TransitionRelation::TransitionRelation(SymVariables *sVars,
         existsVars *= swapVarsS[i];
         existsBwVars *= swapVarsSp[i];
     }
-//    DEBUG_MSG(cout << "Computing tr took " << tr_timer; tBDD.print(1, 1););
+}
+
+void TransitionRelation::partition(const vector<BDD> &factorBDDs, int maxClusterNodes) {
+    assert(factorBDDs.size() == effVars.size());
+    clusters.clear();
+    clusterExistsVars.clear();
+    clusterExistsBwVars.clear();
+
+    //Order the factors by the level of their topmost BDD variable
+    vector<pair<int, int>> factorsByLevel;
+    for (size_t i = 0; i < effVars.size(); ++i) {
+        int level = numeric_limits<int>::max();
+        for (int bdd_var : sV->vars_index_pre(effVars[i])) {
+            level = min(level, sV->mgr()->ReadPerm(bdd_var));
+        }
+        for (int bdd_var : sV->vars_index_eff(effVars[i])) {
+            level = min(level, sV->mgr()->ReadPerm(bdd_var));
+        }
+        factorsByLevel.emplace_back(level, i);
+    }
+    sort(factorsByLevel.begin(), factorsByLevel.end());
+
+    for (const auto &entry : factorsByLevel) {
+        int var = effVars[entry.second];
+        const BDD &factorBDD = factorBDDs[entry.second];
+        BDD existsPre = sV->getCubePre(var);
+        BDD existsEff = sV->getCubeEff(var);
+        if (!clusters.empty()) {
+            BDD conj = clusters.back() * factorBDD;
+            if (conj.nodeCount() <= maxClusterNodes) {
+                clusters.back() = conj;
+                clusterExistsVars.back() *= existsPre;
+                clusterExistsBwVars.back() *= existsEff;
+                continue;
+            }
+        }
+        clusters.push_back(factorBDD);
+        clusterExistsVars.push_back(existsPre);
+        clusterExistsBwVars.push_back(existsEff);
+    }
+}
+
+BDD TransitionRelation::relprod(const BDD &from, bool fw, int maxNodes) const {
+    if (clusters.empty()) {
+        return tBDD.AndAbstract(from, fw ? existsVars : existsBwVars, maxNodes);
+    }
+    //Each variable of effVars appears only in the cluster of its factor, so
+    //it can be quantified as soon as that cluster has been conjoined.
+    const vector<BDD> &exists = fw ? clusterExistsVars : clusterExistsBwVars;
+    BDD res = from;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        res = res.AndAbstract(clusters[i], exists[i], maxNodes);
+    }
+    return res;
 }
 
 void TransitionRelation::shrink(const SymStateSpaceManager &abs, int maxNodes) {
     tBDD = abs.shrinkTBDD(tBDD, maxNodes);
+    clusters.clear();
+    clusterExistsVars.clear();
+    clusterExistsBwVars.clear();
 
     // effVars
     vector <int> newEffVars;
@@ -68,7 +121,7 @@ BDD TransitionRelation::image(const BDD &from) const {
     if (!swapVarsA.empty()) {
         aux = from.SwapVariables(swapVarsA, swapVarsAp);
     }
-    BDD tmp = tBDD.AndAbstract(aux, existsVars);
+    BDD tmp = relprod(aux, true, 0);
     BDD res = tmp.SwapVariables(swapVarsS, swapVarsSp);
     if (absAfterImage) {
         //TODO: HACK: PARAMETER FIXED
@@ -85,7 +138,7 @@ BDD TransitionRelation::image(const BDD &from, int maxNodes) const {
         aux = from.SwapVariables(swapVarsA, swapVarsAp);
     }
     utils::Timer t;
-    BDD tmp = tBDD.AndAbstract(aux, existsVars, maxNodes);
+    BDD tmp = relprod(aux, true, maxNodes);
     DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t();
               );
     BDD res = tmp.SwapVariables(swapVarsS, swapVarsSp);
@@ -104,7 +157,7 @@ BDD TransitionRelation::image(const BDD &from, int maxNodes) const {
 
 BDD TransitionRelation::preimage(const BDD &from) const {
     BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
-    BDD res = tBDD.AndAbstract(tmp, existsBwVars);
+    BDD res = relprod(tmp, false, 0);
     if (!swapVarsA.empty()) {
         res = res.SwapVariables(swapVarsA, swapVarsAp);
     }
@@ -121,7 +174,7 @@ BDD TransitionRelation::preimage(const BDD &from, int maxNodes) const {
     BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
     DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t() << flush;
               );
-    BDD res = tBDD.AndAbstract(tmp, existsBwVars, maxNodes);
+    BDD res = relprod(tmp, false, maxNodes);
     if (!swapVarsA.empty()) {
         res = res.SwapVariables(swapVarsA, swapVarsAp);
     }
@@ -183,6 +236,10 @@ void TransitionRelation::merge(const TransitionRelation &t2,
     }
 
     tBDD = newTBDD;
+    //The disjunction of two TRs cannot be partitioned conjunctively
+    clusters.clear();
+    clusterExistsVars.clear();
+    clusterExistsBwVars.clear();
 
     effVars.swap(newEffVars);
     existsVars *= t2.existsVars;
@@ -29,10 +29,22 @@ class TransitionRelation {
     std::vector<BDD> swapVarsS, swapVarsSp; // Swap variables s to sp and viceversa
     std::vector<BDD> swapVarsA, swapVarsAp; // Swap abstraction variables
 
+    //Conjunctive partition of tBDD, ordered by BDD variable order. If it is
+    //not empty, image and preimage conjoin the clusters one by one and
+    //quantify the variables of each cluster right after conjoining it.
+    std::vector<BDD> clusters;
+    std::vector<BDD> clusterExistsVars, clusterExistsBwVars;
+
     std::set<const OperatorID *> ops; //List of operators represented by the TR
     std::set<int> labels; //List of labels represented by the TR
 
     const SymStateSpaceManager *absAfterImage;
+
+    void init_swap_vars();
+
+    //Relational product of from with tBDD or the clusters, quantifying the
+    //source (fw) or target (bw) variables of effVars
+    BDD relprod(const BDD &from, bool fw, int maxNodes) const;
 public:
     //Constructor for abstraction transitions
 //    TransitionRelation(SymStateSpaceManager *mgr, const DominanceRelation &sim_relations);
@@ -40,7 +52,14 @@ public:
     //Constructor for transitions irrelevant for the abstraction
 //    TransitionRelation(SymVariables *sVars, const GlobalOperator *op, int cost_);
 
-    TransitionRelation(SymVariables *sVars, int label, const std::shared_ptr<task_representation::FTSTask> &_task);
+    //Constructor for the transitions of a label, given as tBDD over effVars.
+    //Factors in which the label is a self-loop everywhere need not be part
+    //of effVars (frame-free TR), their values are kept by image/preimage.
+    TransitionRelation(SymVariables *sVars, int label, const BDD &tBDD_, const std::vector<int> &effVars_,
+                       const std::shared_ptr<task_representation::FTSTask> &_task);
+
+    //Copy of the TR of another label with exactly the same transitions
+    TransitionRelation(const TransitionRelation &other, int label);
 
     //Copy constructor
     TransitionRelation(const TransitionRelation &) = default;
@@ -59,6 +78,16 @@ public:
     void merge(const TransitionRelation &t2,
                int maxNodes);
 
+    //Splits the TR into clusters of factors for partitioned image
+    //computation. factorBDDs contains the BDD of each factor in effVars.
+    //Consecutive factors in BDD variable order are conjoined into the same
+    //cluster as long as it has at most maxClusterNodes nodes.
+    void partition(const std::vector<BDD> &factorBDDs, int maxClusterNodes);
+
+    inline bool isPartitioned() const {
+        return !clusters.empty();
+    }
+
     //shrinks the transition to another abstract state space (useful to preserve edeletion)
     void shrink(const SymStateSpaceManager &abs, int maxNodes);
 
@@ -108,6 +137,9 @@ public:
         this->swapVarsAp = other.swapVarsAp;
         this->swapVarsS = other.swapVarsS;
         this->swapVarsSp = other.swapVarsSp;
+        this->clusters = other.clusters;
+        this->clusterExistsVars = other.clusterExistsVars;
+        this->clusterExistsBwVars = other.clusterExistsBwVars;
 
         return *this;
     }
@@ -29,6 +29,8 @@ namespace symbolic {
     void UnidirectionalSearch::statistics() const {
 	cout << "Exp " << (fw ? "fw" : "bw") << " time: " << stats.step_time << "s (img:" <<
 	    stats.image_time << "s, heur: " << stats.time_heuristic_evaluation <<
-	    "s) in " << stats.num_steps_succeeded << " steps ";
+	    "s) in " << stats.num_steps_succeeded << " steps, ";
+	closed->statistics();
+	cout << endl;
     }
 }
@@ -0,0 +1,76 @@
+#include "binary_task_reader.h"
+
+#include "../utils/binary_io.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <cstring>
+
+#if OPERATING_SYSTEM != WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace task_representation {
+// Must match helper_functions.cc in preprocess-h2
+static const char MAGIC[] = "SASBIN";
+
+bool BinaryTaskReader::is_binary(istream &in) {
+    // Text tasks start with "begin_version"
+    return in.peek() == MAGIC[0];
+}
+
+BinaryTaskReader::BinaryTaskReader()
+    : mapped_data(nullptr), mapped_size(0) {
+    const char *data = nullptr;
+    size_t size = 0;
+#if OPERATING_SYSTEM != WINDOWS
+    struct stat file_stat;
+    if (fstat(0, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+        file_stat.st_size > 0) {
+        mapped_size = file_stat.st_size;
+        mapped_data = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, 0, 0);
+        if (mapped_data == MAP_FAILED) {
+            mapped_data = nullptr;
+        } else {
+            data = static_cast<const char *>(mapped_data);
+            size = mapped_size;
+        }
+    }
+#endif
+    if (!data) {
+        const size_t chunk_size = 1 << 20;
+        while (cin) {
+            size_t old_size = buffer.size();
+            buffer.resize(old_size + chunk_size);
+            cin.read(buffer.data() + old_size, chunk_size);
+            buffer.resize(old_size + cin.gcount());
+        }
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+    reader = utils::make_unique_ptr<utils::BinaryReader>(data, size);
+    if (size < sizeof(MAGIC) ||
+        memcmp(reader->read_bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+        cerr << "Binary task does not start with the magic word "
+             << MAGIC << "." << endl;
+        utils::exit_with(utils::ExitCode::INPUT_ERROR);
+    }
+    int version = reader->read_int();
+    if (version != VERSION) {
+        cerr << "Expected binary task version " << VERSION
+             << ", got " << version << "." << endl;
+        utils::exit_with(utils::ExitCode::INPUT_ERROR);
+    }
+}
+
+BinaryTaskReader::~BinaryTaskReader() {
+#if OPERATING_SYSTEM != WINDOWS
+    if (mapped_data)
+        munmap(mapped_data, mapped_size);
+#endif
+}
+}
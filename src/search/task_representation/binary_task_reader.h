@@ -0,0 +1,59 @@
+#ifndef TASK_REPRESENTATION_BINARY_TASK_READER_H
+#define TASK_REPRESENTATION_BINARY_TASK_READER_H
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace utils {
+class BinaryReader;
+}
+
+namespace task_representation {
+/*
+  Reader for the binary task format written by
+  "preprocess-h2 --output_format binary". All integers are 32-bit
+  little-endian and all strings and arrays are prefixed with their length:
+
+    magic "SASBIN\0", version, use metric
+    variables: name, axiom layer, range, range fact names
+    mutex groups: (var, value) facts
+    initial state: values
+    goal: (var, value) facts
+    operators: name, prevail (var, value) facts,
+               effects (conditions (var, value) facts, var, pre, post), cost
+    axioms: conditions (var, value) facts, var, old value, new value
+
+  If the standard input is a regular file, it is mapped into memory;
+  otherwise (e.g. for pipes) it is read into a buffer. The data is decoded
+  with utils::BinaryReader, so malformed input throws a
+  utils::BinaryReadError.
+*/
+class BinaryTaskReader {
+    std::vector<char> buffer;
+    void *mapped_data;
+    std::size_t mapped_size;
+
+    std::unique_ptr<utils::BinaryReader> reader;
+public:
+    static const int VERSION = 1;
+
+    // Checks (without consuming any input) if in starts with the magic word
+    static bool is_binary(std::istream &in);
+
+    // Reads standard input and checks magic word and version
+    BinaryTaskReader();
+    ~BinaryTaskReader();
+    BinaryTaskReader(const BinaryTaskReader &) = delete;
+    BinaryTaskReader &operator=(const BinaryTaskReader &) = delete;
+
+    // Reader for the data following magic word and version
+    utils::BinaryReader &get_reader() {
+        return *reader;
+    }
+};
+}
+
+#endif
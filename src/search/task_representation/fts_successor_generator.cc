@@ -1,20 +1,221 @@
 #include "fts_successor_generator.h"
 
+#include "fts_operators.h"
+#include "fts_task.h"
+#include "label_equivalence_relation.h"
+#include "transition_system.h"
+
+#include "../global_state.h"
+
+#include "../utils/collections.h"
+
+#include <algorithm>
+#include <cassert>
 
 using namespace std;
 
 namespace task_representation {
-FTSSuccessorGenerator::FTSSuccessorGenerator(const FTSTask &task_proxy) {
+FTSSuccessorGenerator::FTSSuccessorGenerator(
+    const FTSTask &fts_task, const vector<FTSOperator> &operators)
+    : root(-1) {
+    int num_variables = fts_task.get_size();
+    int num_operators = operators.size();
+    int num_labels = fts_task.get_num_labels();
+
+    vector<vector<int>> op_indices_by_label(num_labels);
+    for (int op_index = 0; op_index < num_operators; ++op_index) {
+        assert(operators[op_index].get_id().get_index() == op_index);
+        op_indices_by_label[operators[op_index].get_label()].push_back(op_index);
+    }
+
+    /*
+      A label that does not occur in some transition system is never
+      applicable, hence we count the number of transition systems in which
+      each label occurs.
+    */
+    vector<int> num_vars_with_label(num_labels, 0);
+    condition_vars_by_op.resize(num_operators);
+    condition_values_by_op.resize(num_operators);
+    domain_sizes.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        const TransitionSystem &ts = fts_task.get_ts(var);
+        int num_states = ts.get_size();
+        domain_sizes.push_back(num_states);
+        for (const GroupAndTransitions &gat : ts) {
+            if (gat.label_group.empty()) {
+                continue;
+            }
+            const vector<int> &precondition =
+                ts.get_label_precondition(LabelID(*gat.label_group.begin()));
+            bool has_precondition = static_cast<int>(precondition.size()) < num_states;
+            for (int label : gat.label_group) {
+                ++num_vars_with_label[label];
+                for (int op_index : op_indices_by_label[label]) {
+                    int target = -1;
+                    for (const FactPair &effect : operators[op_index].get_effects()) {
+                        if (effect.var == var) {
+                            target = effect.value;
+                            break;
+                        }
+                    }
+                    if (target != -1) {
+                        /*
+                          The label is non-deterministic in this transition
+                          system and the operator is only applicable in the
+                          sources of transitions leading to its target.
+                          Transitions are sorted and unique, so are sources.
+                        */
+                        vector<int> sources;
+                        for (const Transition &t : gat.transitions) {
+                            if (t.target == target) {
+                                sources.push_back(t.src);
+                            }
+                        }
+                        if (static_cast<int>(sources.size()) < num_states) {
+                            condition_vars_by_op[op_index].push_back(var);
+                            condition_values_by_op[op_index].push_back(move(sources));
+                        }
+                    } else if (has_precondition) {
+                        condition_vars_by_op[op_index].push_back(var);
+                        condition_values_by_op[op_index].push_back(precondition);
+                    }
+                }
+            }
+        }
+    }
+
+    vector<int> op_indices;
+    op_indices.reserve(num_operators);
+    for (int op_index = 0; op_index < num_operators; ++op_index) {
+        if (num_vars_with_label[operators[op_index].get_label()] == num_variables) {
+            op_indices.push_back(op_index);
+        }
+    }
+
+    node_cache_by_var.resize(num_variables + 1);
+    root = construct_recursive(op_indices, 0);
+
+    utils::release_vector_memory(domain_sizes);
+    utils::release_vector_memory(condition_vars_by_op);
+    utils::release_vector_memory(condition_values_by_op);
+    utils::release_vector_memory(node_cache_by_var);
 }
+
 FTSSuccessorGenerator::~FTSSuccessorGenerator() = default;
 
-void FTSSuccessorGenerator::generate_applicable_ops(
-    const State &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+int FTSSuccessorGenerator::get_next_condition_var(int op_index, int var) const {
+    const vector<int> &condition_vars = condition_vars_by_op[op_index];
+    auto it = lower_bound(condition_vars.begin(), condition_vars.end(), var);
+    if (it == condition_vars.end()) {
+        return domain_sizes.size();
+    }
+    return *it;
+}
+
+const vector<int> &FTSSuccessorGenerator::get_condition_values(
+    int op_index, int var) const {
+    const vector<int> &condition_vars = condition_vars_by_op[op_index];
+    auto it = lower_bound(condition_vars.begin(), condition_vars.end(), var);
+    assert(it != condition_vars.end() && *it == var);
+    return condition_values_by_op[op_index][it - condition_vars.begin()];
+}
+
+int FTSSuccessorGenerator::add_leaf(const vector<int> &op_indices) {
+    int first = leaf_operators.size();
+    for (int op_index : op_indices) {
+        leaf_operators.emplace_back(op_index);
+    }
+    nodes.emplace_back(NodeType::LEAF, -1, first, leaf_operators.size());
+    return nodes.size() - 1;
+}
+
+int FTSSuccessorGenerator::construct_recursive(
+    const vector<int> &op_indices, int var) {
+    if (op_indices.empty()) {
+        return -1;
+    }
+
+    // Skip all variables on which none of the operators has a precondition.
+    int num_variables = domain_sizes.size();
+    int switch_var = num_variables;
+    for (int op_index : op_indices) {
+        switch_var = min(switch_var, get_next_condition_var(op_index, var));
+    }
+
+    map<vector<int>, int> &node_cache = node_cache_by_var[switch_var];
+    auto it = node_cache.find(op_indices);
+    if (it != node_cache.end()) {
+        return it->second;
+    }
+
+    int node_index;
+    if (switch_var == num_variables) {
+        node_index = add_leaf(op_indices);
+    } else {
+        vector<vector<int>> op_indices_by_value(domain_sizes[switch_var]);
+        vector<int> unconditioned_op_indices;
+        for (int op_index : op_indices) {
+            if (get_next_condition_var(op_index, switch_var) == switch_var) {
+                for (int value : get_condition_values(op_index, switch_var)) {
+                    op_indices_by_value[value].push_back(op_index);
+                }
+            } else {
+                unconditioned_op_indices.push_back(op_index);
+            }
+        }
+
+        vector<int> value_children;
+        value_children.reserve(op_indices_by_value.size());
+        bool has_child = false;
+        for (const vector<int> &value_op_indices : op_indices_by_value) {
+            value_children.push_back(construct_recursive(value_op_indices, switch_var + 1));
+            has_child |= (value_children.back() != -1);
+        }
+        int switch_index = -1;
+        if (has_child) {
+            int first = children.size();
+            children.insert(children.end(), value_children.begin(), value_children.end());
+            nodes.emplace_back(NodeType::SWITCH, switch_var, first, children.size());
+            switch_index = nodes.size() - 1;
+        }
+
+        int dont_care_index = construct_recursive(unconditioned_op_indices, switch_var + 1);
+        if (switch_index == -1) {
+            node_index = dont_care_index;
+        } else if (dont_care_index == -1) {
+            node_index = switch_index;
+        } else {
+            int first = children.size();
+            children.push_back(switch_index);
+            children.push_back(dont_care_index);
+            nodes.emplace_back(NodeType::FORK, -1, first, children.size());
+            node_index = nodes.size() - 1;
+        }
+    }
+    node_cache[op_indices] = node_index;
+    return node_index;
 }
 
-void FTSSuccessorGenerator::generate_applicable_ops(
-    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+void FTSSuccessorGenerator::generate_applicable_ops_from(
+    int node_index, const GlobalState &state,
+    vector<OperatorID> &applicable_ops) const {
+    // Follow switches iteratively and only recurse into the first child of forks.
+    while (node_index != -1) {
+        const Node &node = nodes[node_index];
+        switch (node.type) {
+        case NodeType::SWITCH:
+            node_index = children[node.first + state[node.var]];
+            break;
+        case NodeType::FORK:
+            generate_applicable_ops_from(children[node.first], state, applicable_ops);
+            node_index = children[node.first + 1];
+            break;
+        case NodeType::LEAF:
+            applicable_ops.insert(applicable_ops.end(),
+                                  leaf_operators.begin() + node.first,
+                                  leaf_operators.begin() + node.last);
+            return;
+        }
+    }
 }
 }
@@ -1,32 +1,97 @@
 #ifndef TASK_REPRESENTATION_FTS_SUCCESSOR_GENERATOR_H
 #define TASK_REPRESENTATION_FTS_SUCCESSOR_GENERATOR_H
 
-#include <memory>
+#include "../operator_id.h"
+
+#include <map>
 #include <vector>
 
 class GlobalState;
-class OperatorID;
 
 namespace task_representation {
+class FTSOperator;
 class FTSTask;
-class State;
 
+/*
+  Decision-tree successor generator over the variables (transition systems)
+  of an FTS task, in the spirit of the successor generator for SAS+ tasks
+  (see task_utils/successor_generator.h).
+
+  In contrast to SAS+ operators, the precondition of an FTS operator on a
+  variable is a *set* of values: the label precondition of its label in that
+  transition system (TransitionSystem::get_label_precondition), or, for
+  variables on which the label is non-deterministic, the sources of the
+  transitions leading to the target chosen by the operator. Hence, operators
+  may be stored in several children of a switch node. Subtrees are shared
+  between all nodes that lead to the same set of operators on the same
+  variable, so the tree is really a DAG.
+
+  All nodes are stored in a single vector and refer to each other by index:
+
+  - switch: children[first + value] for each value of the switch variable,
+    or -1 if no operator is applicable for that value.
+  - fork: children[first] and children[first + 1], which are evaluated both.
+  - leaf: leaf_operators[first, ..., last - 1].
+*/
 class FTSSuccessorGenerator {
+    enum class NodeType {
+        SWITCH,
+        FORK,
+        LEAF
+    };
 
-public:
-    explicit FTSSuccessorGenerator(const FTSTask &task_proxy);
+    struct Node {
+        NodeType type;
+        int var;
+        int first;
+        int last;
+
+        Node(NodeType type, int var, int first, int last)
+            : type(type), var(var), first(first), last(last) {
+        }
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> children;
+    std::vector<OperatorID> leaf_operators;
+    int root;
+
+    // Only used during construction.
+    std::vector<int> domain_sizes;
     /*
-      We cannot use the default destructor (implicitly or explicitly)
-      here because GeneratorBase is a forward declaration and the
-      incomplete type cannot be destroyed.
+      For every operator, the variables on which it has a precondition (in
+      increasing order) and for each of them the sorted list of values in
+      which the operator is applicable.
     */
+    std::vector<std::vector<int>> condition_vars_by_op;
+    std::vector<std::vector<std::vector<int>>> condition_values_by_op;
+    std::vector<std::map<std::vector<int>, int>> node_cache_by_var;
+
+    int get_next_condition_var(int op_index, int var) const;
+    const std::vector<int> &get_condition_values(int op_index, int var) const;
+    int add_leaf(const std::vector<int> &op_indices);
+    int construct_recursive(const std::vector<int> &op_indices, int var);
+
+    void generate_applicable_ops_from(
+        int node_index, const GlobalState &state,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    FTSSuccessorGenerator(
+        const FTSTask &fts_task, const std::vector<FTSOperator> &operators);
     ~FTSSuccessorGenerator();
 
     void generate_applicable_ops(
-        const State &state, std::vector<OperatorID> &applicable_ops) const;
-    // Transitional method, used until the search is switched to the new task interface.
-    void generate_applicable_ops(
-        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const;
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const {
+        generate_applicable_ops_from(root, state, applicable_ops);
+    }
+
+    int get_num_nodes() const {
+        return nodes.size();
+    }
+
+    int get_num_leaf_entries() const {
+        return leaf_operators.size();
+    }
 };
 }
 
@@ -6,6 +6,7 @@
 
 #include "../global_state.h"
 #include "search_task.h"
+#include "../utils/binary_io.h"
 #include "../utils/memory.h"
 #include "../plan.h"
 #include "../task_transformation/distances.h"
@@ -92,6 +93,23 @@ namespace task_representation {
 #endif
     }
 
+    FTSTask::FTSTask(utils::BinaryReader &in)
+        : labels(utils::make_unique_ptr<Labels>(in)) {
+        int num_transition_systems = in.read_count();
+        for (int i = 0; i < num_transition_systems; ++i) {
+            transition_systems.push_back(
+                utils::make_unique_ptr<TransitionSystem>(in, *labels));
+        }
+    }
+
+    void FTSTask::save(utils::BinaryWriter &out) const {
+        labels->save(out);
+        out.write_int(transition_systems.size());
+        for (const auto &ts : transition_systems) {
+            ts->save(out);
+        }
+    }
+
     FTSTask::~FTSTask() {
         for (auto &transition_system : transition_systems) {
             transition_system = nullptr;
@@ -14,6 +14,11 @@ namespace int_packer {
     class IntPacker;
 }
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_transformation {
 class FactoredTransitionSystem;
 }
@@ -45,6 +50,8 @@ public:
 
     FTSTask(const FTSTask & other, OperatorCost cost_type);
 
+    explicit FTSTask(utils::BinaryReader &in);
+
     ~FTSTask();
 
     // We forbid moving tasks around. Ideally, we should use shared_pointers, or references to refer to them.
@@ -81,6 +88,8 @@ public:
 
     std::shared_ptr<SearchTask> get_search_task(bool print_time = false) const;
 
+    void save(utils::BinaryWriter &out) const;
+
     void dump() const;
     friend std::ostream &operator<<(std::ostream &os, const FTSTask &task);    
 };
@@ -1,6 +1,7 @@
 #include "label_equivalence_relation.h"
 
 #include "labels.h"
+#include "../utils/binary_io.h"
 #include "../utils/collections.h"
 
 #include "../task_transformation/types.h"
@@ -114,6 +115,58 @@ LabelEquivalenceRelation::LabelEquivalenceRelation(
     }
 }
 
+LabelEquivalenceRelation::LabelEquivalenceRelation(
+    const Labels &labels, utils::BinaryReader &in)
+    : labels(labels) {
+    int num_groups = in.read_count();
+    vector<vector<int>> group_labels;
+    vector<int> group_costs;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        group_costs.push_back(in.read_int());
+        group_labels.push_back(in.read_ints());
+    }
+
+    /*
+      Like the copy constructor, we restore label_to_positions also on unused
+      positions. Only the group IDs of these positions are meaningful.
+    */
+    vector<int> group_of_label = in.read_ints();
+    label_to_positions.resize(group_of_label.size());
+    for (size_t label_no = 0; label_no < group_of_label.size(); ++label_no) {
+        label_to_positions[label_no].first = LabelGroupID(group_of_label[label_no]);
+    }
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        grouped_labels.push_back(LabelGroup());
+        LabelGroup &label_group = grouped_labels.back();
+        for (int label_no : group_labels[group_id]) {
+            if (!utils::in_bounds(label_no, label_to_positions)) {
+                throw utils::BinaryReadError(
+                    "label " + to_string(label_no) + " out of range");
+            }
+            LabelIter label_it = label_group.insert(label_no);
+            if (group_of_label[label_no] == group_id) {
+                label_to_positions[label_no].second = label_it;
+            }
+        }
+        label_group.set_cost(group_costs[group_id]);
+    }
+}
+
+void LabelEquivalenceRelation::save(utils::BinaryWriter &out) const {
+    out.write_int(grouped_labels.size());
+    for (size_t group_id = 0; group_id < grouped_labels.size(); ++group_id) {
+        const LabelGroup &label_group = grouped_labels[group_id];
+        out.write_int(label_group.get_cost());
+        out.write_ints(vector<int>(label_group.begin(), label_group.end()));
+    }
+    vector<int> group_of_label;
+    group_of_label.reserve(label_to_positions.size());
+    for (const auto &position : label_to_positions) {
+        group_of_label.push_back(position.first);
+    }
+    out.write_ints(group_of_label);
+}
+
 void LabelEquivalenceRelation::add_label_to_group(LabelGroupID group_id,
                                                   int label_no) {
     assert(utils::in_bounds(group_id, grouped_labels));
@@ -13,6 +13,11 @@ namespace task_transformation {
     class LabelMapping;
 }
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_representation {
 class Labels;
 
@@ -95,6 +100,10 @@ public:
       NOTE: we also need it to add the copy of the labels object.
     */
     LabelEquivalenceRelation(const LabelEquivalenceRelation &other, const Labels &labels);
+    // Reads a relation written by save, including the IDs of empty groups.
+    LabelEquivalenceRelation(const Labels &labels, utils::BinaryReader &in);
+
+    void save(utils::BinaryWriter &out) const;
 
     /*
       The given label mappings (from label reduction) contain the new label
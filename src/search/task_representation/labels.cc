@@ -1,5 +1,6 @@
 #include "labels.h"
 
+#include "../utils/binary_io.h"
 #include "../utils/collections.h"
 #include "../utils/memory.h"
 
@@ -62,6 +63,32 @@ Labels::Labels(const Labels &other)
     }
 }
 
+Labels::Labels(utils::BinaryReader &in) {
+    int num_labels = in.read_count();
+    labels.reserve(num_labels);
+    for (int label_no = 0; label_no < num_labels; ++label_no) {
+        if (in.read_bool()) {
+            labels.push_back(utils::make_unique_ptr<Label>(in.read_int()));
+        } else {
+            labels.push_back(nullptr);
+        }
+    }
+    max_size = in.read_int();
+    num_active_entries = in.read_int();
+}
+
+void Labels::save(utils::BinaryWriter &out) const {
+    out.write_int(labels.size());
+    for (const unique_ptr<Label> &label : labels) {
+        out.write_bool(label != nullptr);
+        if (label) {
+            out.write_int(label->get_cost());
+        }
+    }
+    out.write_int(max_size);
+    out.write_int(num_active_entries);
+}
+
 // Due to the LabelMap pointer
 Labels::~Labels() {
 }
@@ -7,6 +7,11 @@
 #include "../task_transformation/label_map.h"
 #include "../operator_cost.h"
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_representation {
 class SASTask;
 
@@ -44,6 +49,7 @@ public:
         int max_size);
 
     Labels(const Labels & other, OperatorCost cost_type);
+    explicit Labels(utils::BinaryReader &in);
 
     task_transformation::LabelMapping  cleanup();
         
@@ -70,6 +76,8 @@ public:
 
     void remove_labels(const std::vector<LabelID> & labels);
 
+    void save(utils::BinaryWriter &out) const;
+
 //    const std::vector<int> &get_sas_op_indices_for_label(int label) const {
 //        return sas_op_indices_by_label[label];
 //    }
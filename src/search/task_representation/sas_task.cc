@@ -4,7 +4,9 @@
 #include <fstream>
 #include <limits>
 
+#include "binary_task_reader.h"
 #include "sas_operator.h"
+#include "../utils/binary_io.h"
 #include "../utils/system.h"
 #include "../utils/timer.h"
 #include "fact.h"
@@ -90,21 +92,25 @@ void SASTask::read_mutexes(istream &in) {
             invariant_group.emplace_back(var, value);
         }
         check_magic(in, "end_mutex_group");
-        for (const FactPair &fact1 : invariant_group) {
-            for (const FactPair &fact2 : invariant_group) {
-                if (fact1.var != fact2.var) {
-                    /* The "different variable" test makes sure we
-                       don't mark a fact as mutex with itself
-                       (important for correctness) and don't include
-                       redundant mutexes (important to conserve
-                       memory). Note that the translator (at least
-                       with default settings) removes mutex groups
-                       that contain *only* redundant mutexes, but it
-                       can of course generate mutex groups which lead
-                       to *some* redundant mutexes, where some but not
-                       all facts talk about the same variable. */
-                    g_inconsistent_facts[fact1.var][fact1.value].insert(fact2);
-                }
+        add_mutex_group(invariant_group);
+    }
+}
+
+void SASTask::add_mutex_group(const vector<FactPair> &invariant_group) {
+    for (const FactPair &fact1 : invariant_group) {
+        for (const FactPair &fact2 : invariant_group) {
+            if (fact1.var != fact2.var) {
+                /* The "different variable" test makes sure we
+                   don't mark a fact as mutex with itself
+                   (important for correctness) and don't include
+                   redundant mutexes (important to conserve
+                   memory). Note that the translator (at least
+                   with default settings) removes mutex groups
+                   that contain *only* redundant mutexes, but it
+                   can of course generate mutex groups which lead
+                   to *some* redundant mutexes, where some but not
+                   all facts talk about the same variable. */
+                g_inconsistent_facts[fact1.var][fact1.value].insert(fact2);
             }
         }
     }
@@ -211,22 +217,23 @@ void SASTask::read_operators(istream &in) {
     in >> count;
     for (int i = 0; i < count; ++i) {
         SASOperator op (in, false, g_use_metric, g_min_action_cost, g_max_action_cost);
+        add_operator(op);
+    }
+}
 
-        set<int> condition_variables;
-        for (const auto & eff : op.get_effects()) {
-            for (const auto & cond : eff.conditions ) {
-                condition_variables.insert(cond.var);
-            }
-        }
-        if (condition_variables.empty()) {
-            g_operators.push_back(op);
-        } else {
-            vector<int> cvars(condition_variables.begin(), condition_variables.end());
-            vector<SASCondition> multiplied_conditions;
-            multiply_out_conditions(op, cvars, 0, multiplied_conditions);
+void SASTask::add_operator(const SASOperator &op) {
+    set<int> condition_variables;
+    for (const auto & eff : op.get_effects()) {
+        for (const auto & cond : eff.conditions ) {
+            condition_variables.insert(cond.var);
         }
-
-
+    }
+    if (condition_variables.empty()) {
+        g_operators.push_back(op);
+    } else {
+        vector<int> cvars(condition_variables.begin(), condition_variables.end());
+        vector<SASCondition> multiplied_conditions;
+        multiply_out_conditions(op, cvars, 0, multiplied_conditions);
     }
 }
 
@@ -273,6 +280,147 @@ void SASTask::read_from_file(istream &in)  {
     // g_state_packer = new int_packer::IntPacker(g_variable_domain);
     // cout << "done! [t=" << utils::g_timer << "]" << endl;
 
+    print_input_statistics();
+}
+
+void SASTask::read_from_stdin() {
+    if (BinaryTaskReader::is_binary(cin)) {
+        cout << "reading binary input... [t=" << utils::g_timer << "]" << endl;
+        try {
+            BinaryTaskReader reader;
+            read_from_binary(reader.get_reader());
+        } catch (const utils::BinaryReadError &error) {
+            cerr << "Invalid binary task: " << error.msg << endl;
+            utils::exit_with(utils::ExitCode::INPUT_ERROR);
+        }
+        cout << "done reading input! [t=" << utils::g_timer << "]" << endl;
+        print_input_statistics();
+    } else {
+        read_from_file(cin);
+    }
+}
+
+/*
+  Reads the same data as read_from_file, see binary_task_reader.h for the
+  layout. Operators, conditional effects and mutexes are processed as for
+  the text format.
+*/
+void SASTask::read_from_binary(utils::BinaryReader &reader) {
+    g_use_metric = reader.read_int();
+
+    // Minimum sizes of the elements: a string or int takes at least 4 bytes.
+    int num_vars = reader.read_count(12);
+    for (int var = 0; var < num_vars; ++var) {
+        g_variable_name.push_back(reader.read_string());
+        g_axiom_layers.push_back(reader.read_int());
+        int range = reader.read_count(4);
+        g_variable_domain.push_back(range);
+        vector<string> fact_names(range);
+        for (string &fact_name : fact_names)
+            fact_name = reader.read_string();
+        g_fact_names.push_back(move(fact_names));
+    }
+
+    g_inconsistent_facts.resize(num_vars);
+    for (int var = 0; var < num_vars; ++var)
+        g_inconsistent_facts[var].resize(g_variable_domain[var]);
+    int num_mutex_groups = reader.read_count(4);
+    for (int i = 0; i < num_mutex_groups; ++i) {
+        int num_facts = reader.read_count(8);
+        vector<FactPair> invariant_group;
+        invariant_group.reserve(num_facts);
+        for (int j = 0; j < num_facts; ++j) {
+            int var = reader.read_int();
+            int value = reader.read_int();
+            check_fact(var, value);
+            invariant_group.emplace_back(var, value);
+        }
+        add_mutex_group(invariant_group);
+    }
+
+    if (reader.read_count(4) != num_vars) {
+        cerr << "Initial state does not assign all variables." << endl;
+        utils::exit_with(utils::ExitCode::INPUT_ERROR);
+    }
+    g_initial_state_data.resize(num_vars);
+    for (int var = 0; var < num_vars; ++var) {
+        g_initial_state_data[var] = reader.read_int();
+        check_fact(var, g_initial_state_data[var]);
+    }
+    g_default_axiom_values = g_initial_state_data;
+
+    int num_goals = reader.read_count(8);
+    if (num_goals < 1) {
+        cerr << "Task has no goal condition!" << endl;
+        utils::exit_with(utils::ExitCode::INPUT_ERROR);
+    }
+    for (int i = 0; i < num_goals; ++i) {
+        int var = reader.read_int();
+        int value = reader.read_int();
+        check_fact(var, value);
+        g_goal.push_back(make_pair(var, value));
+    }
+
+    auto read_conditions = [&](vector<SASCondition> &conditions) {
+            int count = reader.read_count(8);
+            conditions.reserve(conditions.size() + count);
+            for (int i = 0; i < count; ++i) {
+                int var = reader.read_int();
+                int value = reader.read_int();
+                check_fact(var, value);
+                conditions.emplace_back(var, value);
+            }
+        };
+    // Effect with its condition and precondition (if pre != -1)
+    auto read_pre_post = [&](vector<SASCondition> &preconditions,
+                             vector<SASEffect> &effects) {
+            vector<SASCondition> conditions;
+            read_conditions(conditions);
+            int var = reader.read_int();
+            int pre = reader.read_int();
+            int post = reader.read_int();
+            if (pre != -1)
+                check_fact(var, pre);
+            check_fact(var, post);
+            if (pre != -1)
+                preconditions.emplace_back(var, pre);
+            effects.emplace_back(var, post, conditions);
+        };
+
+    int num_operators = reader.read_count(16);
+    for (int i = 0; i < num_operators; ++i) {
+        string name = reader.read_string();
+        vector<SASCondition> preconditions;
+        read_conditions(preconditions);
+        int num_effects = reader.read_count(16);
+        vector<SASEffect> effects;
+        effects.reserve(num_effects);
+        for (int j = 0; j < num_effects; ++j)
+            read_pre_post(preconditions, effects);
+        int op_cost = reader.read_int();
+        int cost = g_use_metric ? op_cost : 1;
+        g_min_action_cost = min(g_min_action_cost, cost);
+        g_max_action_cost = max(g_max_action_cost, cost);
+        add_operator(SASOperator(false, move(preconditions), move(effects),
+                                 move(name), cost));
+    }
+
+    int num_axioms = reader.read_count(16);
+    for (int i = 0; i < num_axioms; ++i) {
+        vector<SASCondition> preconditions;
+        vector<SASEffect> effects;
+        read_pre_post(preconditions, effects);
+        g_axioms.emplace_back(true, move(preconditions), move(effects),
+                              "<axiom>", 0);
+    }
+
+    if (!reader.at_end()) {
+        cerr << "Unexpected data after the end of the binary task." << endl;
+        utils::exit_with(utils::ExitCode::INPUT_ERROR);
+    }
+}
+
+void SASTask::print_input_statistics() const {
     int num_vars = g_variable_domain.size();
     int num_facts = 0;
     for (int var = 0; var < num_vars; ++var)
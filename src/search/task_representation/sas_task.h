@@ -20,6 +20,10 @@ class Options;
 
 class GlobalState;
 
+namespace utils {
+class BinaryReader;
+}
+
 namespace task_representation {
 struct FactPair;
 class SASTask {
@@ -51,6 +55,12 @@ class SASTask {
     void read_goal(std::istream &in);
     void read_operators(std::istream &in);
     void read_axioms(std::istream &in);
+    void read_from_binary(utils::BinaryReader &reader);
+
+    // Shared by the text and binary readers
+    void add_mutex_group(const std::vector<FactPair> &invariant_group);
+    void add_operator(const SASOperator &op);
+    void print_input_statistics() const;
 
 
 // TODO: This needs a proper type and should be moved to a separate
@@ -75,6 +85,8 @@ class SASTask {
 public:
     SASTask();
     void read_from_file(std::istream &in);
+    // Reads the task from standard input in text or binary format
+    void read_from_stdin();
     ~SASTask() = default;
     int get_num_variables() const ;
     std::string get_variable_name(int var) const ;
@@ -1,6 +1,7 @@
 ﻿#include "search_task.h"
 
 #include "fts_operators.h"
+#include "fts_successor_generator.h"
 #include "fts_task.h"
 #include "label_equivalence_relation.h"
 #include "labels.h"
@@ -59,6 +60,7 @@ namespace task_representation {
             fts_task(fts_task),
             state_packer(move(compute_state_packer(fts_task))),
             //    axiom_evaluator (fts_task),
+            successor_generator_type(SuccessorGeneratorType::BITSET),
             min_operator_cost(fts_task.get_min_operator_cost()) {
         size_t num_variables = fts_task.get_size();
         int num_labels = fts_task.get_num_labels();
@@ -98,8 +100,24 @@ namespace task_representation {
         }
     }
 
+    SearchTask::~SearchTask() {
+    }
+
+    void SearchTask::set_successor_generator_type(SuccessorGeneratorType type) {
+        successor_generator_type = type;
+        if (type == SuccessorGeneratorType::DECISION_TREE && !successor_generator) {
+            utils::Timer timer;
+            cout << "Building successor generator..." << endl;
+            successor_generator = utils::make_unique_ptr<FTSSuccessorGenerator>(fts_task, operators);
+            cout << "Done building successor generator with "
+                 << successor_generator->get_num_nodes() << " nodes and "
+                 << successor_generator->get_num_leaf_entries()
+                 << " leaf entries: " << timer << endl;
+        }
+    }
+
     bool SearchTask::is_label_group_relevant(
-            int num_states, const vector<Transition> &transitions) {
+            int num_states, const TransitionList &transitions) {
         if (static_cast<int>(transitions.size()) == num_states) {
             /*
               A label group is irrelevant it has exactly a self-loop transition
@@ -116,7 +134,7 @@ namespace task_representation {
         return false;
     }
 
-    bool SearchTask::are_transitions_deterministic(const vector<Transition> &transitions) {
+    bool SearchTask::are_transitions_deterministic(const TransitionList &transitions) {
         set<int> sources;
         for (const Transition &t : transitions) {
             if (sources.count(t.src)) {
@@ -172,15 +190,15 @@ namespace task_representation {
             const TransitionSystem &ts = fts_task.get_ts(var);
             for (const GroupAndTransitions &gat : ts) {
                 const LabelGroup &label_group = gat.label_group;
-                const vector<Transition> &transitions = gat.transitions;
+                const TransitionList &transitions = gat.transitions;
                 if (is_label_group_relevant(ts.get_size(), transitions)) {
                     bool deterministic = are_transitions_deterministic(transitions);
                     if (deterministic) {
                         int single_target = -1;
                         bool is_single_target = true;
-                        unordered_map<int, int> src_to_target;
+                        vector<int> src_to_target(ts.get_size(), -1);
                         for (const Transition &t : transitions) {
-                            assert(!src_to_target.count(t.src));
+                            assert(src_to_target[t.src] == -1);
                             src_to_target[t.src] = t.target;
                             if (single_target == -1) {
                                 single_target = t.target;
@@ -194,9 +212,12 @@ namespace task_representation {
                                 label_to_info[label_id].static_effects.push_back(FactPair(var, single_target));
                             }
                         } else {
+                            int offset = src_to_target_tables.size();
+                            src_to_target_tables.insert(src_to_target_tables.end(),
+                                                        src_to_target.begin(), src_to_target.end());
                             for (int label_id : label_group) {
                                 label_to_info[label_id].relevant_deterministic_transition_systems.push_back(var);
-                                label_to_info[label_id].src_to_target_by_ts_index.push_back(src_to_target);
+                                label_to_info[label_id].src_to_target_offset_by_ts_index.push_back(offset);
                             }
                         }
 
@@ -270,169 +291,126 @@ namespace task_representation {
                 }
             }
         }
-    }
 
-    bool SearchTask::is_goal_state(const GlobalState &state) const {
-        // TODO: should use our own method in the long term
-        return fts_task.is_goal_state(state);
-    }
-
-    bool SearchTask::is_goal_state(const PlanState &state) const {
-        // TODO: should use our own method in the long term
-        return fts_task.is_goal_state(state);
+        create_effect_records();
     }
 
-    bool SearchTask::has_effect(const GlobalState &predecessor, OperatorID op_id, const FactPair &fact) const {
-        // Ideally, we would assert that the operator is applicable.
-        const FTSOperator &fts_op = operators[op_id.get_index()];
-        LabelID label = fts_op.get_label();
-
-        // Static Effects
-        for (const auto &eff : label_to_info[label].static_effects) {
-            if (eff == fact) {
-                return true;
+    void SearchTask::create_effect_records() {
+        effect_record_start.reserve(operators.size() + 1);
+        for (const FTSOperator &op : operators) {
+            const LabelInformation &info = label_to_info[op.get_label()];
+            effect_record_start.push_back(effect_records.size());
+            effect_records.push_back(info.static_effects.size() + op.get_effects().size());
+            effect_records.push_back(info.relevant_deterministic_transition_systems.size());
+            for (const FactPair &eff : info.static_effects) {
+                effect_records.push_back(eff.var);
+                effect_records.push_back(eff.value);
             }
-        }
-
-        // Effects on non-deterministic TS
-        for (const FactPair &effect : fts_op.get_effects()) {
-            if (effect == fact) {
-                return true;
+            for (const FactPair &eff : op.get_effects()) {
+                effect_records.push_back(eff.var);
+                effect_records.push_back(eff.value);
+            }
+            for (size_t ts_index = 0;
+                 ts_index < info.relevant_deterministic_transition_systems.size(); ++ts_index) {
+                effect_records.push_back(info.relevant_deterministic_transition_systems[ts_index]);
+                effect_records.push_back(info.src_to_target_offset_by_ts_index[ts_index]);
             }
         }
+        effect_record_start.push_back(effect_records.size());
 
-        // Effects on deterministic TS
-        const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index = label_to_info[label].src_to_target_by_ts_index;
-        for (size_t ts_index = 0; ts_index < det_ts.size(); ++ts_index) {
-            int var = det_ts[ts_index];
-            if (var == fact.var &&
-                src_to_target_by_ts_index[ts_index].at(predecessor[var]) == fact.value) {
-                return true;
+        create_packed_effects();
+    }
+
+    void SearchTask::create_packed_effects() {
+        /*
+          Assignments and lookups affect disjoint variables, hence lookups
+          can read the old value from the buffer after the assignments.
+        */
+        int num_operators = operators.size();
+        packed_assignment_start.reserve(num_operators + 1);
+        packed_lookup_start.reserve(num_operators + 1);
+        for (int op_index = 0; op_index < num_operators; ++op_index) {
+            const int *record = &effect_records[effect_record_start[op_index]];
+            const int num_assignments = record[0];
+            const int num_lookups = record[1];
+            record += 2;
+            vector<pair<int, int>> var_values;
+            var_values.reserve(num_assignments);
+            for (int i = 0; i < num_assignments; ++i, record += 2) {
+                var_values.emplace_back(record[0], record[1]);
+            }
+            packed_assignment_start.push_back(packed_assignments.size());
+            vector<int_packer::IntPacker::BinAssignment> assignments =
+                state_packer->compute_bin_assignments(var_values);
+            packed_assignments.insert(packed_assignments.end(), assignments.begin(), assignments.end());
+
+            packed_lookup_start.push_back(packed_lookups.size());
+            for (int i = 0; i < num_lookups; ++i, record += 2) {
+                packed_lookups.push_back({state_packer->get_variable_location(record[0]), record[1]});
             }
         }
+        packed_assignment_start.push_back(packed_assignments.size());
+        packed_lookup_start.push_back(packed_lookups.size());
+    }
 
-        return false;
+    bool SearchTask::is_goal_state(const GlobalState &state) const {
+        // TODO: should use our own method in the long term
+        return fts_task.is_goal_state(state);
+    }
 
-//    axiom_evaluator.evaluate(buffer, *state_packer);
+    bool SearchTask::is_goal_state(const PlanState &state) const {
+        // TODO: should use our own method in the long term
+        return fts_task.is_goal_state(state);
     }
 
-// We only need predecessor to access certain variables' values.
-    void SearchTask::apply_operator(
-            const GlobalState &predecessor, OperatorID op_id, PackedStateBin *buffer) const {
+    bool SearchTask::has_effect(const GlobalState &predecessor, OperatorID op_id, const FactPair &fact) const {
         // Ideally, we would assert that the operator is applicable.
-        const FTSOperator &fts_op = operators[op_id.get_index()];
-
-        LabelID label = fts_op.get_label();
-        // Static Effects
-        for (const auto &eff : label_to_info[label].static_effects) {
-            state_packer->set(buffer, eff.var, eff.value);
-        }
-
-        // Effects on deterministic TS
-        const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index = label_to_info[label].src_to_target_by_ts_index;
-        for (size_t ts_index = 0; ts_index < det_ts.size(); ++ts_index) {
-            int var = det_ts[ts_index];
-            const unordered_map<int, int> &src_to_target = src_to_target_by_ts_index[ts_index];
-            state_packer->set(buffer, var, src_to_target.at(predecessor[var]));
-        }
-
-        // Effects on non-deterministic TS
-        for (const FactPair &effect : fts_op.get_effects()) {
-            state_packer->set(buffer, effect.var, effect.value);
-        }
-//    axiom_evaluator.evaluate(buffer, *state_packer);
+        bool found = false;
+        apply_effects(predecessor, op_id, [&](int var, int value) {
+                found |= (var == fact.var && value == fact.value);
+            });
+        return found;
     }
 
     // We only need predecessor to access certain variables' values.
     void SearchTask::apply_operator(
             const GlobalState &predecessor, OperatorID op_id, vector<int> &buffer) const {
         // Ideally, we would assert that the operator is applicable.
-        const FTSOperator &fts_op = operators[op_id.get_index()];
-
-        LabelID label = fts_op.get_label();
-        // Static Effects
-        for (const auto &eff : label_to_info[label].static_effects) {
-            buffer[eff.var] = eff.value;
-        }
-
-        // Effects on deterministic TS
-        const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index =
-                label_to_info[label].src_to_target_by_ts_index;
-        for (size_t ts_index = 0; ts_index < det_ts.size(); ++ts_index) {
-            int var = det_ts[ts_index];
-            const unordered_map<int, int> &src_to_target = src_to_target_by_ts_index[ts_index];
-            buffer[var] = src_to_target.at(predecessor[var]);
-        }
-
-        // Effects on non-deterministic TS
-        for (const FactPair &effect : fts_op.get_effects()) {
-            buffer[effect.var] = effect.value;
-        }
+        apply_effects(predecessor, op_id, [&](int var, int value) {
+                buffer[var] = value;
+            });
     }
 
     // We only need predecessor to access certain variables' values.
     void SearchTask::apply_operator(
             const std::vector<int> &predecessor, const OperatorID &op_id, vector<int> &buffer) const {
         // Ideally, we would assert that the operator is applicable.
-        const FTSOperator &fts_op = operators[op_id.get_index()];
-
-        LabelID label = fts_op.get_label();
-        // Static Effects
-        for (const auto &eff : label_to_info[label].static_effects) {
-            buffer[eff.var] = eff.value;
-        }
-
-        // Effects on deterministic TS
-        const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index =
-                label_to_info[label].src_to_target_by_ts_index;
-        for (size_t ts_index = 0; ts_index < det_ts.size(); ++ts_index) {
-            int var = det_ts[ts_index];
-            const unordered_map<int, int> &src_to_target = src_to_target_by_ts_index[ts_index];
-            buffer[var] = src_to_target.at(predecessor[var]);
-        }
-
-        // Effects on non-deterministic TS
-        for (const FactPair &effect : fts_op.get_effects()) {
-            buffer[effect.var] = effect.value;
-        }
+        apply_effects(predecessor, op_id, [&](int var, int value) {
+                buffer[var] = value;
+            });
     }
 
     vector<int> SearchTask::generate_successor(const State &predecessor, OperatorID op_id) const {
         vector<int> successor(predecessor.get_values());
-
-        const FTSOperator &fts_op = operators[op_id.get_index()];
-
-        LabelID label = fts_op.get_label();
-        // Static Effects
-        for (const auto &eff : label_to_info[label].static_effects) {
-            successor[eff.var] = eff.value;
-        }
-
-        // Effects on deterministic TS
-        const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index =
-                label_to_info[label].src_to_target_by_ts_index;
-        for (size_t i = 0; i < det_ts.size(); ++i) {
-            int var = det_ts[i];
-            const unordered_map<int, int> &src_to_target = src_to_target_by_ts_index[i];
-            successor[var] = src_to_target.at(predecessor[var]);
-        }
-
-        // Effects on non-deterministic TS
-        for (const FactPair &effect : fts_op.get_effects()) {
-            successor[effect.var] = effect.value;
-        }
-
+        apply_effects(predecessor, op_id, [&](int var, int value) {
+                successor[var] = value;
+            });
         return successor;
     }
 
 
     void SearchTask::generate_applicable_ops(
             const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+        if (successor_generator_type == SuccessorGeneratorType::BITSET) {
+            generate_applicable_ops_bitset(state, applicable_ops);
+            return;
+        }
+        assert(successor_generator);
+        successor_generator->generate_applicable_ops(state, applicable_ops);
+    }
+
+    void SearchTask::generate_applicable_ops_bitset(
+            const GlobalState &state, vector<OperatorID> &applicable_ops) const {
         size_t var = 0;
 
         boost::dynamic_bitset<> activated_labels = activated_labels_by_var_by_state[var][state[var]];
@@ -518,13 +496,16 @@ namespace task_representation {
         cout << "label ID " << label << ":";
 
         const vector<int> &det_ts = label_to_info[label].relevant_deterministic_transition_systems;
-        const vector<unordered_map<int, int>> &src_to_target_by_ts_index = label_to_info[label].src_to_target_by_ts_index;
+        const vector<int> &src_to_target_offset_by_ts_index = label_to_info[label].src_to_target_offset_by_ts_index;
         for (size_t ts_index = 0; ts_index < det_ts.size(); ++ts_index) {
             int var = det_ts[ts_index];
-            const unordered_map<int, int> &src_to_target = src_to_target_by_ts_index[ts_index];
-            for (const pair<int, int> var_val : src_to_target) {
-                cout << " [var" << var << ": " << var_val.first << "] [var" << var << ":= "
-                     << var_val.second << "]";
+            int offset = src_to_target_offset_by_ts_index[ts_index];
+            for (int src = 0; src < fts_task.get_ts(var).get_size(); ++src) {
+                int target = src_to_target_tables[offset + src];
+                if (target != -1) {
+                    cout << " [var" << var << ": " << src << "] [var" << var << ":= "
+                         << target << "]";
+                }
             }
         }
 
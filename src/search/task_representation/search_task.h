@@ -6,26 +6,30 @@
 
 #include "fts_operators.h"
 #include "../global_state.h"
+#include "../algorithms/int_packer.h"
 #include "../operator_id.h"
 #include "../plan.h"
 
 
 #include <memory>
 #include <set>
-#include <unordered_map>
 
 #include <boost/dynamic_bitset.hpp>
 
-namespace int_packer {
-    class IntPacker;
-}
-
 namespace task_representation {
     class FTSTask;
 
     class State;
 
-    class Transition;
+    struct Transition;
+    class TransitionList;
+
+    class FTSSuccessorGenerator;
+
+    enum class SuccessorGeneratorType {
+        BITSET,
+        DECISION_TREE
+    };
 
     struct OperatorTreeNode {
         int variable;
@@ -118,6 +122,14 @@ namespace task_representation {
 
         std::vector<FTSOperator> operators;
         std::vector<std::vector<boost::dynamic_bitset<>>> activated_labels_by_var_by_state;
+
+        SuccessorGeneratorType successor_generator_type;
+        /*
+          Decision tree over the variables, built when it is selected with
+          set_successor_generator_type, so that generate_applicable_ops
+          only reads it and can be called concurrently.
+        */
+        std::unique_ptr<FTSSuccessorGenerator> successor_generator;
         //std::vector<OperatorTree> operator_tree;
 
         struct LabelInformation {
@@ -127,10 +139,11 @@ namespace task_representation {
             // The set of transition systems (ids) in which the label is relevant
             // and deterministic.
             std::vector<int> relevant_deterministic_transition_systems;
-            // Mapping of source to target states of each relevant deterministic
-            // TS. That is, this vector is indexed by indices of above vector and
-            // *not* the id of the TS itself.
-            std::vector<std::unordered_map<int, int>> src_to_target_by_ts_index;
+            // Offset into src_to_target_tables of the table mapping source to
+            // target states of each relevant deterministic TS. That is, this
+            // vector is indexed by indices of above vector and *not* the id of
+            // the TS itself.
+            std::vector<int> src_to_target_offset_by_ts_index;
 
             // The set of transition systems (ids) in which the label is relevant
             // and has at least one non-deterministic transition.
@@ -145,14 +158,51 @@ namespace task_representation {
         };
         std::vector<LabelInformation> label_to_info;
 
+        /*
+          Dense source to target tables of all relevant deterministic label
+          groups, stored back to back. The table of a TS with n states
+          occupies n entries, with -1 for states without outgoing transition.
+          Tables are shared by all labels of a label group.
+        */
+        std::vector<int> src_to_target_tables;
+
+        /*
+          Flat effect record of every FTS operator, stored back to back in
+          effect_records starting at effect_record_start[op_id]:
+            [num_assignments, num_lookups,
+             var_1, value_1, ..., var_k, value_k,
+             var_1, table_offset_1, ..., var_l, table_offset_l]
+          Assignments comprise the static effects of the label and the
+          effects on the non-deterministic TS of the operator. Lookups
+          are the effects on deterministic TS, whose new value is
+          src_to_target_tables[table_offset + old value].
+        */
+        std::vector<int> effect_records;
+        std::vector<int> effect_record_start;
+
+        /*
+          The same effects in terms of the packed state representation, used
+          to apply operators directly to packed buffers: the assignments of
+          each operator combined into one update per touched bin, and the
+          locations of the variables of its lookups.
+        */
+        struct PackedLookup {
+            int_packer::IntPacker::VariableLocation location;
+            int table_offset;
+        };
+        std::vector<int_packer::IntPacker::BinAssignment> packed_assignments;
+        std::vector<int> packed_assignment_start;
+        std::vector<PackedLookup> packed_lookups;
+        std::vector<int> packed_lookup_start;
+
         std::vector<int> goal_relevant_transition_systems;
 
         const int min_operator_cost;
 
         bool is_label_group_relevant(
-                int num_states, const std::vector<Transition> &transitions);
+                int num_states, const TransitionList &transitions);
 
-        bool are_transitions_deterministic(const std::vector<Transition> &transitions);
+        bool are_transitions_deterministic(const TransitionList &transitions);
 
         void multiply_out_non_deterministic_labels(
                 LabelID label_id,
@@ -162,8 +212,39 @@ namespace task_representation {
 
         void create_fts_operators();
 
+        void create_effect_records();
+
+        void create_packed_effects();
+
+        void generate_applicable_ops_bitset(
+                const GlobalState &state,
+                std::vector<OperatorID> &applicable_ops) const;
+
     public:
         SearchTask(const FTSTask &fts_task, bool print_time);
+        ~SearchTask();
+
+        /*
+          Calls set_value(var, value) for every effect of op_id applied in
+          predecessor, which must support operator[] on variables.
+        */
+        template<typename Predecessor, typename SetValue>
+        void apply_effects(const Predecessor &predecessor, OperatorID op_id,
+                           SetValue set_value) const {
+            const int *record = &effect_records[effect_record_start[op_id.get_index()]];
+            const int num_assignments = record[0];
+            const int num_lookups = record[1];
+            record += 2;
+            for (int i = 0; i < num_assignments; ++i, record += 2) {
+                set_value(record[0], record[1]);
+            }
+            for (int i = 0; i < num_lookups; ++i, record += 2) {
+                const int var = record[0];
+                set_value(var, src_to_target_tables[record[1] + predecessor[var]]);
+            }
+        }
+
+        void set_successor_generator_type(SuccessorGeneratorType type);
 
         bool is_goal_state(const GlobalState &state) const;
 
@@ -171,7 +252,24 @@ namespace task_representation {
 
         bool has_effect(const GlobalState &predecessor, OperatorID op_id, const FactPair &fact) const;
 
-        void apply_operator(const GlobalState &predecessor, OperatorID op, PackedStateBin *buffer) const;
+        /*
+          Apply op to the packed state in buffer, which must hold the packed
+          predecessor and is updated in place.
+        */
+        void apply_operator(OperatorID op, PackedStateBin *buffer) const {
+            const int op_index = op.get_index();
+            for (int i = packed_assignment_start[op_index];
+                 i < packed_assignment_start[op_index + 1]; ++i) {
+                int_packer::IntPacker::apply(buffer, packed_assignments[i]);
+            }
+            for (int i = packed_lookup_start[op_index];
+                 i < packed_lookup_start[op_index + 1]; ++i) {
+                const PackedLookup &lookup = packed_lookups[i];
+                int value = int_packer::IntPacker::get(buffer, lookup.location);
+                int_packer::IntPacker::set(
+                    buffer, lookup.location, src_to_target_tables[lookup.table_offset + value]);
+            }
+        }
 
         void apply_operator(const GlobalState &predecessor, OperatorID op, std::vector<int> &buffer) const;
 
@@ -15,8 +15,13 @@
 #include <string>
 #include <vector>
 
+class Heuristic;
+
 namespace task_representation {
 class State {
+    // Heuristics refill a reusable State in place to avoid allocations.
+    friend class ::Heuristic;
+
     const FTSTask *task;
     std::vector<int> values; // We represent dead end states by an empty vector of values.
 public:
@@ -0,0 +1,153 @@
+#include "transition_list.h"
+
+#include "../utils/collections.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace task_representation {
+static void append_varint(vector<uint8_t> &bytes, unsigned int value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+TransitionList::TransitionList(vector<Transition> &&transitions, bool compact)
+    : num_transitions(0), compact(false) {
+    assign(move(transitions), compact);
+}
+
+void TransitionList::encode(const vector<Transition> &sorted_transitions) {
+    assert(utils::is_sorted_unique(sorted_transitions));
+    encoded.clear();
+    int last_src = 0;
+    size_t run_start = 0;
+    while (run_start < sorted_transitions.size()) {
+        int src = sorted_transitions[run_start].src;
+        size_t run_end = run_start + 1;
+        while (run_end < sorted_transitions.size() &&
+               sorted_transitions[run_end].src == src) {
+            ++run_end;
+        }
+        append_varint(encoded, src - last_src);
+        append_varint(encoded, run_end - run_start - 1);
+        int last_target = sorted_transitions[run_start].target;
+        append_varint(encoded, last_target);
+        for (size_t i = run_start + 1; i < run_end; ++i) {
+            int target = sorted_transitions[i].target;
+            append_varint(encoded, target - last_target - 1);
+            last_target = target;
+        }
+        last_src = src;
+        run_start = run_end;
+    }
+    // The terminating empty run.
+    encoded.insert(encoded.end(), 3, 0);
+    encoded.shrink_to_fit();
+}
+
+vector<Transition> TransitionList::decode_all() const {
+    vector<Transition> result;
+    result.reserve(num_transitions);
+    result.assign(begin(), end());
+    return result;
+}
+
+void TransitionList::assign(vector<Transition> &&new_transitions, bool compact_mode) {
+    num_transitions = new_transitions.size();
+    compact = compact_mode;
+    if (compact && num_transitions) {
+        encode(new_transitions);
+        utils::release_vector_memory(new_transitions);
+        utils::release_vector_memory(transitions);
+    } else {
+        transitions = move(new_transitions);
+        utils::release_vector_memory(encoded);
+    }
+}
+
+vector<Transition> TransitionList::extract() {
+    vector<Transition> result;
+    if (compact) {
+        result = decode_all();
+    } else {
+        result = move(transitions);
+    }
+    clear();
+    return result;
+}
+
+void TransitionList::set_compact(bool compact_mode) {
+    if (compact_mode != compact) {
+        assign(extract(), compact_mode);
+    }
+}
+
+void TransitionList::clear() {
+    num_transitions = 0;
+    utils::release_vector_memory(transitions);
+    utils::release_vector_memory(encoded);
+}
+
+TransitionList::const_iterator TransitionList::begin() const {
+    if (!compact) {
+        return const_iterator(transitions.data(), nullptr, 0);
+    }
+    const_iterator it(nullptr, encoded.data(), 0);
+    if (num_transitions)
+        it.read_run();
+    return it;
+}
+
+TransitionList::const_iterator TransitionList::end() const {
+    if (!compact) {
+        return const_iterator(transitions.data() + transitions.size(), nullptr, 0);
+    }
+    return const_iterator(nullptr, nullptr, num_transitions);
+}
+
+pair<TransitionList::const_iterator, TransitionList::const_iterator>
+TransitionList::get_transitions_from(int src) const {
+    if (!compact) {
+        auto range = equal_range(
+            transitions.begin(), transitions.end(), Transition(src, 0),
+            [](const Transition &lhs, const Transition &rhs) {
+                return lhs.src < rhs.src;
+            });
+        const Transition *first = transitions.data() + (range.first - transitions.begin());
+        const Transition *last = transitions.data() + (range.second - transitions.begin());
+        return make_pair(const_iterator(first, nullptr, 0),
+                         const_iterator(last, nullptr, 0));
+    }
+
+    // Skip over the runs of smaller sources.
+    const_iterator it(nullptr, encoded.data(), 0);
+    while (it.index < num_transitions) {
+        it.read_run();
+        if (it.current.src == src) {
+            int run_end = it.index + it.remaining_in_run + 1;
+            return make_pair(it, const_iterator(nullptr, nullptr, run_end));
+        } else if (it.current.src > src) {
+            break;
+        }
+        it.index += it.remaining_in_run + 1;
+        for (; it.remaining_in_run; --it.remaining_in_run)
+            decode(it.pos);
+    }
+    return make_pair(end(), end());
+}
+
+bool TransitionList::operator==(const TransitionList &other) const {
+    if (num_transitions != other.num_transitions)
+        return false;
+    if (compact == other.compact) {
+        return compact ? encoded == other.encoded
+                       : transitions == other.transitions;
+    }
+    return equal(begin(), end(), other.begin());
+}
+}
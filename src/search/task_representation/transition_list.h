@@ -0,0 +1,193 @@
+#ifndef TASK_REPRESENTATION_TRANSITION_LIST_H
+#define TASK_REPRESENTATION_TRANSITION_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace task_representation {
+struct Transition {
+    int src;
+    int target;
+
+    Transition(int src, int target)
+        : src(src), target(target) {
+    }
+
+    bool operator==(const Transition &other) const {
+        return src == other.src && target == other.target;
+    }
+
+    bool operator<(const Transition &other) const {
+        return src < other.src || (src == other.src && target < other.target);
+    }
+
+    // Required for "is_sorted_unique" in utilities
+    bool operator>=(const Transition &other) const {
+        return !(*this < other);
+    }
+};
+
+/*
+  The sorted and duplicate-free transitions of one label group.
+
+  By default, the transitions are stored in a plain vector. In compact
+  mode, they are stored as a byte string instead: transitions with the
+  same source form a run, and every run is encoded as the delta to the
+  previous source, the run length minus one and the first target, each
+  as a varint, followed by the deltas (minus one) between consecutive
+  targets of the run. An empty run terminates the encoding, so that
+  iterators can advance past the last transition without a bounds
+  check. Products of transition systems have long runs with close
+  targets, so most transitions take a single byte instead of eight.
+  The price is that the transitions can only be iterated front to
+  back and that every modification re-encodes the list.
+
+  Both modes are iterated through the same const_iterator, which hides
+  the storage from users of TransitionSystem.
+*/
+class TransitionList {
+    std::vector<Transition> transitions;
+    std::vector<uint8_t> encoded;
+    int num_transitions;
+    bool compact;
+
+    static int decode(const uint8_t *&pos) {
+        unsigned int value = *pos++;
+        if (value < 0x80)
+            return value;
+        value &= 0x7f;
+        int shift = 7;
+        uint8_t byte;
+        do {
+            byte = *pos++;
+            value |= static_cast<unsigned int>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    void encode(const std::vector<Transition> &sorted_transitions);
+    std::vector<Transition> decode_all() const;
+public:
+    class const_iterator {
+        friend class TransitionList;
+        // Points into the vector in plain mode and is null in compact mode.
+        const Transition *plain;
+        // Decoding state in compact mode.
+        const uint8_t *pos;
+        int index;
+        int remaining_in_run;
+        Transition current;
+
+        const_iterator(const Transition *plain, const uint8_t *pos, int index)
+            : plain(plain), pos(pos), index(index), remaining_in_run(0),
+              current(0, 0) {
+        }
+
+        void read_run() {
+            current.src += decode(pos);
+            remaining_in_run = decode(pos);
+            current.target = decode(pos);
+        }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Transition;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Transition *;
+        using reference = const Transition &;
+
+        reference operator*() const {
+            return plain ? *plain : current;
+        }
+
+        pointer operator->() const {
+            return plain ? plain : &current;
+        }
+
+        const_iterator &operator++() {
+            if (plain) {
+                ++plain;
+            } else {
+                ++index;
+                if (remaining_in_run) {
+                    --remaining_in_run;
+                    current.target += decode(pos) + 1;
+                } else {
+                    // After the last run, this reads the terminating run.
+                    read_run();
+                }
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        /*
+          Iterators of the same list are compared by position in plain
+          mode and by transition index in compact mode.
+        */
+        bool operator==(const const_iterator &rhs) const {
+            return plain == rhs.plain && index == rhs.index;
+        }
+
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    TransitionList()
+        : num_transitions(0), compact(false) {
+    }
+
+    explicit TransitionList(std::vector<Transition> &&transitions,
+                            bool compact = false);
+
+    void assign(std::vector<Transition> &&new_transitions, bool compact_mode);
+
+    // Returns the transitions as a vector and leaves the list empty.
+    std::vector<Transition> extract();
+
+    // Switches the storage mode, re-encoding the transitions if necessary.
+    void set_compact(bool compact_mode);
+
+    // Empties the list and releases its memory.
+    void clear();
+
+    bool is_compact() const {
+        return compact;
+    }
+
+    std::size_t size() const {
+        return num_transitions;
+    }
+
+    bool empty() const {
+        return num_transitions == 0;
+    }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /*
+      Returns the range of transitions with the given source. This is a
+      binary search in plain mode and a scan over the runs in compact
+      mode.
+    */
+    std::pair<const_iterator, const_iterator> get_transitions_from(int src) const;
+
+    bool operator==(const TransitionList &other) const;
+    bool operator!=(const TransitionList &other) const {
+        return !(*this == other);
+    }
+};
+}
+
+#endif
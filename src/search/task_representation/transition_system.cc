@@ -3,6 +3,7 @@
 #include "label_equivalence_relation.h"
 #include "labels.h"
 
+#include "../utils/binary_io.h"
 #include "../utils/collections.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
@@ -36,7 +37,7 @@ static void normalize_given_transitions(vector<Transition> &transitions) {
 
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<TransitionList> &transitions_by_group_id,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
       transitions_by_group_id(transitions_by_group_id),
@@ -87,10 +88,34 @@ TransitionSystem::TransitionSystem(
     vector<bool> &&goal_states,
     int init_state,
     bool compute_label_equivalence_relation)
+    : TransitionSystem(num_variables,
+                       move(incorporated_variables),
+                       move(label_equivalence_relation),
+                       vector<TransitionList>(
+                           make_move_iterator(transitions_by_label.begin()),
+                           make_move_iterator(transitions_by_label.end())),
+                       false,
+                       num_states,
+                       move(goal_states),
+                       init_state,
+                       compute_label_equivalence_relation) {
+}
+
+TransitionSystem::TransitionSystem(
+    int num_variables,
+    vector<int> &&incorporated_variables,
+    unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+    vector<TransitionList> &&transitions_by_group_id,
+    bool compact_transitions,
+    int num_states,
+    vector<bool> &&goal_states,
+    int init_state,
+    bool compute_label_equivalence_relation)
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_label)),
+      transitions_by_group_id(move(transitions_by_group_id)),
+      compact_transitions(compact_transitions),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -107,6 +132,7 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation)),
       transitions_by_group_id(other.transitions_by_group_id),
+      compact_transitions(other.compact_transitions),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -121,14 +147,56 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other, const Labels &
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation, labels)),
       transitions_by_group_id(other.transitions_by_group_id),
+      compact_transitions(other.compact_transitions),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
 }
 
+TransitionSystem::TransitionSystem(utils::BinaryReader &in, const Labels &labels)
+    : num_variables(in.read_int()),
+      incorporated_variables(in.read_ints()),
+      label_equivalence_relation(
+          utils::make_unique_ptr<LabelEquivalenceRelation>(labels, in)),
+      compact_transitions(false) {
+    int num_groups = in.read_count();
+    transitions_by_group_id.resize(num_groups);
+    for (LabelGroupID group_id(0); group_id < num_groups; ++group_id) {
+        vector<int> flat_transitions = in.read_ints();
+        vector<Transition> transitions;
+        transitions.reserve(flat_transitions.size() / 2);
+        for (size_t i = 0; i + 1 < flat_transitions.size(); i += 2) {
+            transitions.emplace_back(flat_transitions[i], flat_transitions[i + 1]);
+        }
+        set_transitions_of_group(group_id, move(transitions));
+    }
+    num_states = in.read_int();
+    goal_states = in.read_bools();
+    init_state = in.read_int();
+}
+
 TransitionSystem::~TransitionSystem() {
 }
 
+void TransitionSystem::save(utils::BinaryWriter &out) const {
+    out.write_int(num_variables);
+    out.write_ints(incorporated_variables);
+    label_equivalence_relation->save(out);
+    out.write_int(transitions_by_group_id.size());
+    for (const TransitionList &transitions : transitions_by_group_id) {
+        vector<int> flat_transitions;
+        flat_transitions.reserve(2 * transitions.size());
+        for (const Transition &transition : transitions) {
+            flat_transitions.push_back(transition.src);
+            flat_transitions.push_back(transition.target);
+        }
+        out.write_ints(flat_transitions);
+    }
+    out.write_int(num_states);
+    out.write_bools(goal_states);
+    out.write_int(init_state);
+}
+
 unique_ptr<TransitionSystem> TransitionSystem::merge(
     const Labels &labels,
     const TransitionSystem &ts1,
@@ -150,7 +218,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         back_inserter(incorporated_variables));
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels);
-    vector<vector<Transition>> transitions_by_group_id(labels.get_max_size());
+    vector<TransitionList> transitions_by_group_id(labels.get_max_size());
+    bool compact_transitions = ts1.compact_transitions || ts2.compact_transitions;
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -182,7 +251,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     vector<int> dead_labels;
     for (const GroupAndTransitions &gat : ts1) {
         const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
+        const TransitionList &transitions1 = gat.transitions;
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
@@ -196,7 +265,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
 
         // Now create the new groups together with their transitions.
         for (const auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
+            const TransitionList &transitions2 =
                 ts2.get_transitions_for_group_id(bucket.first);
 
             // Create the new transitions for this bucket
@@ -224,7 +293,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
             } else {
                 sort(new_transitions.begin(), new_transitions.end());
                 int new_index = label_equivalence_relation->add_label_group(new_labels);
-                transitions_by_group_id[new_index] = move(new_transitions);
+                transitions_by_group_id[new_index].assign(
+                    move(new_transitions), compact_transitions);
             }
         }
     }
@@ -247,6 +317,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         move(incorporated_variables),
         move(label_equivalence_relation),
         move(transitions_by_group_id),
+        compact_transitions,
         num_states,
         move(goal_states),
         init_state,
@@ -261,16 +332,16 @@ void TransitionSystem::compute_locally_equivalent_labels() {
     */
     for (LabelGroupID group_id1 (0); group_id1 < label_equivalence_relation->get_size(); ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            const TransitionList &transitions1 = transitions_by_group_id[group_id1];
             for (LabelGroupID group_id2 (group_id1 + 1);
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
+                    TransitionList &transitions2 = transitions_by_group_id[group_id2];
                     if ((transitions1.empty() && transitions2.empty())
                         || transitions1 == transitions2) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
+                        transitions2.clear();
                     }
                 }
             }
@@ -308,7 +379,7 @@ void TransitionSystem::apply_abstraction(
     goal_state_list.clear();
 
     // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
+    for (TransitionList &transitions : transitions_by_group_id) {
         if (!transitions.empty()) {
             vector<Transition> new_transitions;
             /*
@@ -321,15 +392,14 @@ void TransitionSystem::apply_abstraction(
               positions in the end. This would be more ugly, though.
             */
             new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
+            for (const Transition &transition : transitions) {
                 int src = abstraction_mapping[transition.src];
                 int target = abstraction_mapping[transition.target];
                 if (src != PRUNED_STATE && target != PRUNED_STATE)
                     new_transitions.push_back(Transition(src, target));
             }
             normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+            transitions.assign(move(new_transitions), compact_transitions);
         }
     }
 
@@ -395,7 +465,7 @@ void TransitionSystem::apply_label_reduction(
                 LabelGroupID group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
+                    const TransitionList &transitions = transitions_by_group_id[group_id];
                     new_label_transitions.insert(transitions.begin(), transitions.end());
                 }
             }
@@ -421,14 +491,14 @@ void TransitionSystem::apply_label_reduction(
                 transitions_by_group_id.resize(new_group_id+1);
             }
             assert((size_t)new_group_id < transitions_by_group_id.size());
-            transitions_by_group_id[new_group_id] = move(transitions);
+            set_transitions_of_group(new_group_id, move(transitions));
         }
 
         // Go over all affected group IDs and remove their transitions if the
         // group is empty.
         for (LabelGroupID group_id : affected_group_ids) {
             if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
+                transitions_by_group_id[group_id].clear();
             }
         }
 
@@ -448,6 +518,18 @@ void TransitionSystem::apply_label_mapping(
     selfloop_everywhere_label_groups.clear();
 }
 
+void TransitionSystem::set_compact_transitions(bool compact) {
+    compact_transitions = compact;
+    for (TransitionList &transitions : transitions_by_group_id) {
+        transitions.set_compact(compact);
+    }
+}
+
+void TransitionSystem::set_transitions_of_group(
+    int group_id, vector<Transition> &&transitions) {
+    transitions_by_group_id[group_id].assign(move(transitions), compact_transitions);
+}
+
 
 bool TransitionSystem::remove_labels(const vector<LabelID> & labels) {
     // TODO: This doesn't correctly determine if this ts needs pruning (maybe because there are labels with -1 label group?)
@@ -482,7 +564,11 @@ string TransitionSystem::tag() const {
 
 bool TransitionSystem::are_transitions_sorted_unique() const {
     for (const GroupAndTransitions &gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
+        const TransitionList &transitions = gat.transitions;
+        if (adjacent_find(transitions.begin(), transitions.end(),
+                          [](const Transition &lhs, const Transition &rhs) {
+                              return lhs >= rhs;
+                          }) != transitions.end())
             return false;
     }
     return true;
@@ -532,7 +618,7 @@ void TransitionSystem::dump_dot_graph() const {
     }
     for (const GroupAndTransitions &gat : *this) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionList &transitions = gat.transitions;
         for (const Transition &transition : transitions) {
             int src = transition.src;
             int target = transition.target;
@@ -563,13 +649,11 @@ void TransitionSystem::dump_labels_and_transitions() const {
         }
         cout << endl;
         cout << "transitions: ";
-        const vector<Transition> &transitions = gat.transitions;
-        for (size_t i = 0; i < transitions.size(); ++i) {
-            int src = transitions[i].src;
-            int target = transitions[i].target;
-            if (i != 0)
+        const TransitionList &transitions = gat.transitions;
+        for (auto it = transitions.begin(); it != transitions.end(); ++it) {
+            if (it != transitions.begin())
                 cout << ",";
-            cout << src << " -> " << target;
+            cout << it->src << " -> " << it->target;
         }
         cout << endl;
         cout << "cost: " << label_group.get_cost() << endl;
@@ -594,29 +678,43 @@ const vector<int> & TransitionSystem::get_goal_states() const {
     return goal_state_list;
 }
 
-const std::vector<int> & TransitionSystem::get_label_precondition(LabelID label) const {
-    if (label_group_precondition.empty()) {
-        label_group_precondition.resize(label_equivalence_relation->get_size());
-        for (LabelGroupID group_id (0);
-             group_id < label_equivalence_relation->get_size(); ++group_id) {
-            if (!label_equivalence_relation->is_empty_group(group_id)) {
-                set<int> sources;
-                for(const auto & tr : transitions_by_group_id[group_id]) {
-                    sources.insert(tr.src);
-                }
-                label_group_precondition[group_id].reserve(sources.size());
-                for (int source : sources) {
-                    assert(source < get_size());
-                    label_group_precondition[group_id].push_back(source);
-                }
+void TransitionSystem::compute_label_group_precondition() const {
+    label_group_precondition.resize(label_equivalence_relation->get_size());
+    for (LabelGroupID group_id (0);
+         group_id < label_equivalence_relation->get_size(); ++group_id) {
+        if (!label_equivalence_relation->is_empty_group(group_id)) {
+            set<int> sources;
+            for(const auto & tr : transitions_by_group_id[group_id]) {
+                sources.insert(tr.src);
+            }
+            label_group_precondition[group_id].reserve(sources.size());
+            for (int source : sources) {
+                assert(source < get_size());
+                label_group_precondition[group_id].push_back(source);
             }
         }
     }
+}
 
+const std::vector<int> & TransitionSystem::get_label_precondition(LabelID label) const {
+    if (label_group_precondition.empty()) {
+        compute_label_group_precondition();
+    }
 
     return label_group_precondition[label_equivalence_relation->get_group_id(label)];
 }
 
+void TransitionSystem::compute_cached_data() const {
+    get_goal_states();
+    get_relevant_label_groups();
+    if (label_group_precondition.empty()) {
+        compute_label_group_precondition();
+    }
+    if (selfloop_everywhere_label_groups.empty()) {
+        compute_selfloop_everywhere_label_groups();
+    }
+}
+
     int TransitionSystem::num_label_groups () const {
         return label_equivalence_relation->get_size();
     }
@@ -653,30 +751,34 @@ const std::vector<int> & TransitionSystem::get_label_precondition(LabelID label)
 
     }
 
-    bool TransitionSystem::is_selfloop_everywhere(LabelID label) const {
-
-        if (selfloop_everywhere_label_groups.empty()) {
-            selfloop_everywhere_label_groups.resize(label_equivalence_relation->get_size(), false);
-            for (LabelGroupID group_id (0); group_id < label_equivalence_relation->get_size(); ++group_id) {
-                if (!label_equivalence_relation->is_empty_group(group_id)) {
-                    int num_self_loops = 0;
-                    for(const auto & tr : transitions_by_group_id[group_id]) {
-                        if (tr.src == tr.target) {
-                            num_self_loops ++;
-                        }
-                    }
-                    if (num_self_loops == get_size()) {
-                        selfloop_everywhere_label_groups[group_id] = true;
+    void TransitionSystem::compute_selfloop_everywhere_label_groups() const {
+        selfloop_everywhere_label_groups.resize(label_equivalence_relation->get_size(), false);
+        for (LabelGroupID group_id (0); group_id < label_equivalence_relation->get_size(); ++group_id) {
+            if (!label_equivalence_relation->is_empty_group(group_id)) {
+                int num_self_loops = 0;
+                for(const auto & tr : transitions_by_group_id[group_id]) {
+                    if (tr.src == tr.target) {
+                        num_self_loops ++;
                     }
                 }
+                if (num_self_loops == get_size()) {
+                    selfloop_everywhere_label_groups[group_id] = true;
+                }
             }
+        }
+
+        // cout << endl << endl << endl;
+        // dump_labels_and_transitions();
+        // for (LabelGroupID group_id (0); group_id < label_equivalence_relation->get_size(); ++group_id) {
+        //     cout << selfloop_everywhere_label_groups[group_id] << " ";
+        // }
+        // cout << endl << endl << endl;
+    }
 
-            // cout << endl << endl << endl;
-            // dump_labels_and_transitions();
-            // for (LabelGroupID group_id (0); group_id < label_equivalence_relation->get_size(); ++group_id) {
-            //     cout << selfloop_everywhere_label_groups[group_id] << " ";
-            // }
-            // cout << endl << endl << endl;
+    bool TransitionSystem::is_selfloop_everywhere(LabelID label) const {
+
+        if (selfloop_everywhere_label_groups.empty()) {
+            compute_selfloop_everywhere_label_groups();
         }
 
         LabelGroupID label_group = label_equivalence_relation->get_group_id(label);
@@ -701,7 +803,7 @@ bool TransitionSystem::is_unit_cost() const {
     return true;
 }
 
-const std::vector<Transition> &TransitionSystem::get_transitions_with_label(int label_id) const {
+const TransitionList &TransitionSystem::get_transitions_with_label(int label_id) const {
     return transitions_by_group_id[label_equivalence_relation->get_group_id(label_id)];
 }
 
@@ -740,7 +842,8 @@ const std::vector<Transition> &TransitionSystem::get_transitions_with_label(int
     }
 
     void TransitionSystem::remove_transitions_from_goal()  {
-        for (auto  & trs : transitions_by_group_id) {
+        for (LabelGroupID group_id(0); group_id < int(transitions_by_group_id.size()); ++group_id) {
+            vector<Transition> trs = transitions_by_group_id[group_id].extract();
             //Only remove self loops if the labels will be dead (only applicable on goal states)
             bool should_remove_self_loops = std::all_of(trs.begin(), trs.end(),
                                                      [&](const Transition & tr) {
@@ -751,7 +854,7 @@ const std::vector<Transition> &TransitionSystem::get_transitions_with_label(int
                         return goal_states[tr.src] &&
                             (should_remove_self_loops || tr.src != tr.target);
                     }), trs.end());
-            
+            set_transitions_of_group(group_id, move(trs));
         }
     }
 
@@ -767,13 +870,14 @@ const std::vector<Transition> &TransitionSystem::get_transitions_with_label(int
             label_ids.emplace_back(kv_pair.first);
             LabelGroupID lg_id = get_label_group_id_of_label(LabelID(kv_pair.first));
 
-            assert(is_sorted(transitions_by_group_id[lg_id].begin(), transitions_by_group_id[lg_id].end()));
+            const TransitionList &transitions = transitions_by_group_id[lg_id];
+            assert(is_sorted(transitions.begin(), transitions.end()));
 
             // Insert all old transitions that are not in trs_by_label into new_transitions[label_index]
-            size_t new_size = transitions_by_group_id[lg_id].size() - kv_pair.second.size();
+            size_t new_size = transitions.size() - kv_pair.second.size();
             if (new_size != 0) {
                 new_transitions[label_index].resize(new_size, Transition(0,0));
-                set_difference(transitions_by_group_id[lg_id].begin(),  transitions_by_group_id[lg_id].end(),
+                set_difference(transitions.begin(), transitions.end(),
                                kv_pair.second.begin(),  kv_pair.second.end(),
                                new_transitions[label_index].begin());
             }
@@ -787,7 +891,8 @@ const std::vector<Transition> &TransitionSystem::get_transitions_with_label(int
             if (!new_transitions[label_index].empty()) {
                 label_equivalence_relation->add_label_group(std::vector<int> {label_ids[label_index]});
                 assert(get_label_group_id_of_label(label_ids[label_index]) == int(transitions_by_group_id.size()));
-                transitions_by_group_id.push_back(new_transitions[label_index]);
+                transitions_by_group_id.emplace_back(
+                    move(new_transitions[label_index]), compact_transitions);
             }
         }
 
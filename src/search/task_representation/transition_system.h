@@ -1,6 +1,7 @@
 #ifndef TASK_REPRESENTATION_TRANSITION_SYSTEM_H
 #define TASK_REPRESENTATION_TRANSITION_SYSTEM_H
 
+#include "transition_list.h"
 #include "types.h"
 #include "../task_transformation/types.h"
 #include "../task_transformation/label_map.h"
@@ -17,6 +18,11 @@ namespace task_transformation {
 class Distances;
 }
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 using namespace task_transformation;
 
 namespace task_representation {
@@ -24,34 +30,12 @@ class LabelEquivalenceRelation;
 class LabelGroup;
 class Labels;
 
-struct Transition {
-    int src;
-    int target;
-
-    Transition(int src, int target)
-        : src(src), target(target) {
-    }
-
-    bool operator==(const Transition &other) const {
-        return src == other.src && target == other.target;
-    }
-
-    bool operator<(const Transition &other) const {
-        return src < other.src || (src == other.src && target < other.target);
-    }
-
-    // Required for "is_sorted_unique" in utilities
-    bool operator>=(const Transition &other) const {
-        return !(*this < other);
-    }
-};
-
 struct GroupAndTransitions {
     LabelGroupID group_id;
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    const TransitionList &transitions;
     GroupAndTransitions(LabelGroupID id, const LabelGroup &label_group,
-                       const std::vector<Transition> &transitions)
+                       const TransitionList &transitions)
         : group_id (id), label_group(label_group),
         transitions(transitions) {
     }
@@ -65,14 +49,14 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<TransitionList> &transitions_by_group_id;
     // current_group_id is the actual iterator
     LabelGroupID current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<TransitionList> &transitions_by_group_id,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -119,8 +103,13 @@ private:
       incrementally increasing the size of transitions_of_groups whenever a
       new label group is added also increases runtime. See also issue492 and
       issue521.
+
+      With compact_transitions, the lists are stored varint-encoded (see
+      TransitionList), which trades runtime for fitting larger products
+      into memory. Merging inherits the storage mode of the components.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<TransitionList> transitions_by_group_id;
+    bool compact_transitions;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -138,12 +127,18 @@ private:
     //List of label groups that have a selfloop transition in every state
     mutable std::vector<bool> selfloop_everywhere_label_groups;
 
+    void compute_label_group_precondition() const;
+    void compute_selfloop_everywhere_label_groups() const;
+
     /*
       Check if two or more labels are locally equivalent to each other, and
       if so, update the label equivalence relation.
     */
     void compute_locally_equivalent_labels();
 
+    void set_transitions_of_group(
+        int group_id, std::vector<Transition> &&transitions);
+
     // Statistics and output
     std::string get_description() const;
 
@@ -157,8 +152,19 @@ public:
         std::vector<bool> &&goal_states,
         int init_state,
         bool compute_label_equivalence_relation);
+    TransitionSystem(
+        int num_variables,
+        std::vector<int> &&incorporated_variables,
+        std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
+        std::vector<TransitionList> &&transitions_by_group_id,
+        bool compact_transitions,
+        int num_states,
+        std::vector<bool> &&goal_states,
+        int init_state,
+        bool compute_label_equivalence_relation);
     TransitionSystem(const TransitionSystem &other);
     TransitionSystem(const TransitionSystem &other, const Labels &labels);
+    TransitionSystem(utils::BinaryReader &in, const Labels &labels);
     ~TransitionSystem();
     /*
       Factory method to construct the merge of two transition systems.
@@ -193,6 +199,9 @@ public:
         bool only_equivalent_labels);
 
     void apply_label_mapping(const task_transformation::LabelMapping &label_mapping);
+
+    // Switches the storage of all transitions to or from compact mode.
+    void set_compact_transitions(bool compact);
     bool remove_labels(const std::vector<LabelID> & labels);
 
     TSConstIterator begin() const {
@@ -225,12 +234,14 @@ public:
     int compute_total_transitions() const;
     bool is_solvable(const Distances &distances) const;
 
+    void save(utils::BinaryWriter &out) const;
+
     void dump_dot_graph() const;
     void dump_labels_and_transitions() const;
     void statistics() const;
     bool is_unit_cost() const;
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
+    const TransitionList &get_transitions_for_group_id(int group_id) const {
         return transitions_by_group_id[group_id];
     }
 
@@ -250,6 +261,15 @@ public:
         return incorporated_variables;
     }
 
+    /*
+      The goal state list, the label preconditions, the relevant label
+      groups and the groups that are self-loops everywhere are computed
+      on first use by the const getters below. Computing them in advance
+      makes these getters read-only, so that they can be called from
+      several threads.
+    */
+    void compute_cached_data() const;
+
     const std::vector<int> & get_goal_states() const;
 
     const std::vector<bool> & get_is_goal() const {
@@ -279,7 +299,7 @@ public:
 
     bool is_selfloop_everywhere(LabelID label) const;
 
-    const std::vector<Transition> &get_transitions_with_label(int label_id) const ;
+    const TransitionList &get_transitions_with_label(int label_id) const ;
 
     friend std::ostream &operator<<(std::ostream &os, const TransitionSystem &tr);
 
@@ -0,0 +1,336 @@
+#include "bisimulation_partition_refinement.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace task_transformation {
+namespace {
+/*
+  The states of each group are stored contiguously in elements from begin
+  to end. States marked for the next split are moved to the front of the
+  range, i.e., between begin and marked_end. Groups of the same compound
+  block form a doubly linked list.
+*/
+struct Group {
+    int begin;
+    int end;
+    int marked_end;
+    int compound;
+    int prev;
+    int next;
+
+    int size() const {
+        return end - begin;
+    }
+};
+
+struct Compound {
+    int first_group;
+    int num_groups;
+    bool in_queue;
+};
+
+class PartitionRefinement {
+    vector<int> elements;
+    vector<int> position;
+    vector<int> &state_to_group;
+    vector<Group> groups;
+    vector<Compound> compounds;
+    // Compound blocks with more than one group
+    vector<int> queue;
+    vector<int> touched_groups;
+
+    void add_to_compound(int group, int compound) {
+        Compound &c = compounds[compound];
+        Group &g = groups[group];
+        g.compound = compound;
+        g.prev = -1;
+        g.next = c.first_group;
+        if (c.first_group != -1) {
+            groups[c.first_group].prev = group;
+        }
+        c.first_group = group;
+        ++c.num_groups;
+        if (c.num_groups == 2 && !c.in_queue) {
+            c.in_queue = true;
+            queue.push_back(compound);
+        }
+    }
+
+    void remove_from_compound(int group) {
+        Group &g = groups[group];
+        Compound &c = compounds[g.compound];
+        if (g.prev == -1) {
+            c.first_group = g.next;
+        } else {
+            groups[g.prev].next = g.next;
+        }
+        if (g.next != -1) {
+            groups[g.next].prev = g.prev;
+        }
+        --c.num_groups;
+    }
+
+public:
+    PartitionRefinement(int num_states, vector<int> &state_to_group,
+                        int num_groups)
+        : elements(num_states),
+          position(num_states),
+          state_to_group(state_to_group) {
+        // Sort the states by group.
+        vector<int> group_begin(num_groups + 1, 0);
+        for (int state = 0; state < num_states; ++state) {
+            ++group_begin[state_to_group[state] + 1];
+        }
+        partial_sum(group_begin.begin(), group_begin.end(), group_begin.begin());
+        groups.reserve(num_states);
+        for (int group = 0; group < num_groups; ++group) {
+            int begin = group_begin[group];
+            groups.push_back({begin, begin, begin, -1, -1, -1});
+        }
+        for (int state = 0; state < num_states; ++state) {
+            Group &group = groups[state_to_group[state]];
+            position[state] = group.end;
+            elements[group.end++] = state;
+        }
+
+        compounds.push_back({-1, 0, false});
+        for (int group = 0; group < num_groups; ++group) {
+            add_to_compound(group, 0);
+        }
+    }
+
+    int get_num_groups() const {
+        return groups.size();
+    }
+
+    void mark(int state) {
+        Group &group = groups[state_to_group[state]];
+        int pos = position[state];
+        if (pos < group.marked_end) {
+            return;
+        }
+        if (group.marked_end == group.begin) {
+            touched_groups.push_back(state_to_group[state]);
+        }
+        int other = elements[group.marked_end];
+        swap(elements[pos], elements[group.marked_end]);
+        position[other] = pos;
+        position[state] = group.marked_end;
+        ++group.marked_end;
+    }
+
+    // Split every touched group into its marked and unmarked states.
+    void split_touched_groups() {
+        for (int group_id : touched_groups) {
+            Group &group = groups[group_id];
+            int marked_end = group.marked_end;
+            group.marked_end = group.begin;
+            if (marked_end == group.end) {
+                continue;
+            }
+            int new_group_id = groups.size();
+            groups.push_back({group.begin, marked_end, group.begin, -1, -1, -1});
+            Group &old_group = groups[group_id];
+            old_group.begin = marked_end;
+            old_group.marked_end = marked_end;
+            for (int i = groups[new_group_id].begin; i < marked_end; ++i) {
+                state_to_group[elements[i]] = new_group_id;
+            }
+            add_to_compound(new_group_id, old_group.compound);
+        }
+        touched_groups.clear();
+    }
+
+    /*
+      Remove the smaller one of two groups from a compound block with more
+      than one group and make it a compound block of its own. Return the
+      group or -1 if all compound blocks consist of a single group.
+    */
+    int pop_splitter() {
+        while (!queue.empty()) {
+            Compound &compound = compounds[queue.back()];
+            if (compound.num_groups < 2) {
+                compound.in_queue = false;
+                queue.pop_back();
+                continue;
+            }
+            int first = compound.first_group;
+            int second = groups[first].next;
+            int splitter = groups[first].size() <= groups[second].size() ?
+                first : second;
+            remove_from_compound(splitter);
+            if (compound.num_groups < 2) {
+                compound.in_queue = false;
+                queue.pop_back();
+            }
+            int new_compound = compounds.size();
+            compounds.push_back({-1, 0, false});
+            add_to_compound(splitter, new_compound);
+            return splitter;
+        }
+        return -1;
+    }
+
+    const Group &get_group(int group) const {
+        return groups[group];
+    }
+
+    int get_state(int pos) const {
+        return elements[pos];
+    }
+};
+}
+
+int refine_to_coarsest_bisimulation(
+    int num_states,
+    const vector<LabeledTransition> &transitions,
+    vector<int> &state_to_group,
+    int num_groups) {
+    PartitionRefinement partition(num_states, state_to_group, num_groups);
+
+    int num_labels = 0;
+    for (const LabeledTransition &transition : transitions) {
+        num_labels = max(num_labels, transition.label + 1);
+    }
+
+    int num_transitions = transitions.size();
+    vector<int> order(num_transitions);
+    iota(order.begin(), order.end(), 0);
+    auto by_label_and_src = [&](int lhs, int rhs) {
+        const LabeledTransition &t1 = transitions[lhs];
+        const LabeledTransition &t2 = transitions[rhs];
+        if (t1.label != t2.label)
+            return t1.label < t2.label;
+        return t1.src < t2.src;
+    };
+    // Transitions of transition systems are usually sorted already.
+    if (!is_sorted(order.begin(), order.end(), by_label_and_src)) {
+        sort(order.begin(), order.end(), by_label_and_src);
+    }
+
+    // Make the groups stable with respect to the universe.
+    for (int i = 0; i < num_transitions; ++i) {
+        const LabeledTransition &transition = transitions[order[i]];
+        partition.mark(transition.src);
+        if (i + 1 == num_transitions ||
+            transitions[order[i + 1]].label != transition.label) {
+            partition.split_touched_groups();
+        }
+    }
+
+    // Partitions into single states are stable.
+    if (partition.get_num_groups() == num_states) {
+        return num_states;
+    }
+
+    /*
+      Count the transitions of each source and label into the universe,
+      which is the only compound block initially. The transitions of a
+      source and label share their count.
+    */
+    vector<int> counts;
+    vector<int> count_of_transition(num_transitions);
+    for (int i = 0; i < num_transitions; ++i) {
+        const LabeledTransition &transition = transitions[order[i]];
+        if (i == 0 || transition.label != transitions[order[i - 1]].label ||
+            transition.src != transitions[order[i - 1]].src) {
+            counts.push_back(0);
+        }
+        ++counts.back();
+        count_of_transition[order[i]] = counts.size() - 1;
+    }
+
+    // Incoming transitions of each state
+    vector<int> incoming_begin(num_states + 1, 0);
+    for (const LabeledTransition &transition : transitions) {
+        ++incoming_begin[transition.target + 1];
+    }
+    partial_sum(incoming_begin.begin(), incoming_begin.end(),
+                incoming_begin.begin());
+    vector<int> incoming(num_transitions);
+    {
+        vector<int> next_pos(incoming_begin.begin(), incoming_begin.end() - 1);
+        for (int i = 0; i < num_transitions; ++i) {
+            incoming[next_pos[transitions[i].target]++] = i;
+        }
+    }
+
+    vector<vector<int>> transitions_by_label(num_labels);
+    vector<int> touched_labels;
+    vector<int> count_into_splitter(num_states, 0);
+    vector<int> count_into_compound(num_states);
+    vector<int> sources;
+
+    while (partition.get_num_groups() < num_states) {
+        int splitter = partition.pop_splitter();
+        if (splitter == -1) {
+            break;
+        }
+
+        const Group &group = partition.get_group(splitter);
+        for (int pos = group.begin; pos < group.end; ++pos) {
+            int state = partition.get_state(pos);
+            for (int i = incoming_begin[state]; i < incoming_begin[state + 1]; ++i) {
+                int transition_id = incoming[i];
+                int label = transitions[transition_id].label;
+                if (transitions_by_label[label].empty()) {
+                    touched_labels.push_back(label);
+                }
+                transitions_by_label[label].push_back(transition_id);
+            }
+        }
+
+        for (int label : touched_labels) {
+            vector<int> &label_transitions = transitions_by_label[label];
+            for (int transition_id : label_transitions) {
+                int src = transitions[transition_id].src;
+                if (count_into_splitter[src] == 0) {
+                    sources.push_back(src);
+                    count_into_compound[src] = count_of_transition[transition_id];
+                }
+                ++count_into_splitter[src];
+            }
+
+            // Split by the predecessors of the splitter.
+            for (int src : sources) {
+                partition.mark(src);
+            }
+            partition.split_touched_groups();
+
+            /*
+              Split by the predecessors of the splitter which are no
+              predecessors of the rest of its former compound block.
+            */
+            for (int src : sources) {
+                if (count_into_splitter[src] == counts[count_into_compound[src]]) {
+                    partition.mark(src);
+                }
+            }
+            partition.split_touched_groups();
+
+            // Move the transitions into the splitter to new counts.
+            for (int src : sources) {
+                counts[count_into_compound[src]] -= count_into_splitter[src];
+                counts.push_back(count_into_splitter[src]);
+                count_into_compound[src] = counts.size() - 1;
+            }
+            for (int transition_id : label_transitions) {
+                count_of_transition[transition_id] =
+                    count_into_compound[transitions[transition_id].src];
+            }
+
+            for (int src : sources) {
+                count_into_splitter[src] = 0;
+            }
+            sources.clear();
+            label_transitions.clear();
+        }
+        touched_labels.clear();
+    }
+
+    return partition.get_num_groups();
+}
+}
@@ -0,0 +1,41 @@
+#ifndef TASK_TRANSFORMATION_BISIMULATION_PARTITION_REFINEMENT_H
+#define TASK_TRANSFORMATION_BISIMULATION_PARTITION_REFINEMENT_H
+
+#include <vector>
+
+namespace task_transformation {
+struct LabeledTransition {
+    int label;
+    int src;
+    int target;
+
+    LabeledTransition(int label, int src, int target)
+        : label(label), src(src), target(target) {
+    }
+};
+
+/*
+  Refines the partition of states given by state_to_group (with groups
+  0, ..., num_groups - 1) to the coarsest bisimulation of the given labeled
+  transitions and returns its number of groups. Every state remains in a
+  group with the number of its initial group or in a new group numbered
+  num_groups or above.
+
+  This is the partition refinement algorithm by Paige and Tarjan extended
+  to labeled transitions, which runs in O(m log n) time for m transitions
+  and n states: the groups are stable with respect to the blocks of a
+  coarser "compound" partition, and each refinement step splits a compound
+  block into its smaller group and the rest, and splits the groups by the
+  predecessors of the smaller group label by label. To split by the
+  predecessors of the rest without enumerating it, we keep for each
+  transition the number of transitions with the same source and label into
+  the same compound block.
+*/
+extern int refine_to_coarsest_bisimulation(
+    int num_states,
+    const std::vector<LabeledTransition> &transitions,
+    std::vector<int> &state_to_group,
+    int num_groups);
+}
+
+#endif
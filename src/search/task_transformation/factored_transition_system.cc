@@ -13,6 +13,7 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include "label_map.h"
 #include "state_mapping.h"
@@ -50,7 +51,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
         vector<unique_ptr<Distances>> &&distances,
         const bool compute_init_distances,
         const bool compute_goal_distances,
-        Verbosity verbosity, const bool lossy)
+        Verbosity verbosity, const bool lossy,
+        const shared_ptr<utils::ThreadPool> &thread_pool)
         : labels(move(labels_)),
           transition_systems(move(transition_systems)),
           mas_representations(move(mas_representations)),
@@ -60,12 +62,24 @@ FactoredTransitionSystem::FactoredTransitionSystem(
           compute_goal_distances(compute_goal_distances),
           num_active_entries(this->transition_systems.size()),
           predecessor_fts_task(fts_task),
-          lossy_mapping(lossy) {
-    for (size_t index = 0; index < this->transition_systems.size(); ++index) {
-        if (compute_init_distances || compute_goal_distances) {
-            this->distances[index]->compute_distances(
+          lossy_mapping(lossy),
+          thread_pool(thread_pool) {
+    if (compute_init_distances || compute_goal_distances) {
+        // Keep the output of verbose runs in order.
+        if (verbosity >= Verbosity::VERBOSE) {
+            for (size_t index = 0; index < this->transition_systems.size(); ++index) {
+                this->distances[index]->compute_distances(
                     compute_init_distances, compute_goal_distances, verbosity);
+            }
+        } else {
+            this->thread_pool->run(
+                this->transition_systems.size(), [&](int index) {
+                    this->distances[index]->compute_distances(
+                        compute_init_distances, compute_goal_distances, verbosity);
+                });
         }
+    }
+    for (size_t index = 0; index < this->transition_systems.size(); ++index) {
         assert(is_component_valid(index));
     }
 }
@@ -79,7 +93,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(FactoredTransitionSystem &&ot
           compute_init_distances(move(other.compute_init_distances)),
           compute_goal_distances(move(other.compute_goal_distances)),
           num_active_entries(move(other.num_active_entries)),
-          lossy_mapping(other.lossy_mapping) {
+          lossy_mapping(other.lossy_mapping),
+          thread_pool(move(other.thread_pool)) {
     /*
       This is just a default move constructor. Unfortunately Visual
       Studio does not support "= default" for move construction or
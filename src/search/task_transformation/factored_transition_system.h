@@ -16,6 +16,10 @@ class TransitionSystem;
 class FTSTask;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace task_transformation {
 class Distances;
 class FactoredTransitionSystem;
@@ -84,6 +88,9 @@ class FactoredTransitionSystem {
 
     const bool lossy_mapping;
 
+    // Used to process independent factors concurrently.
+    std::shared_ptr<utils::ThreadPool> thread_pool;
+
     /*
       Assert that the factor at the given index is in a consistent state, i.e.
       that there is a transition system, a distances object, and an MSR.
@@ -107,7 +114,8 @@ public:
         const bool compute_init_distances,
         const bool compute_goal_distances,
         Verbosity verbosity,
-        const bool lossy);
+        const bool lossy,
+        const std::shared_ptr<utils::ThreadPool> &thread_pool);
 
     FactoredTransitionSystem(FactoredTransitionSystem &&other);
     ~FactoredTransitionSystem();
@@ -189,6 +197,15 @@ public:
         return num_active_entries;
     }
 
+    /*
+      Used by merge scoring functions, shrink strategies and label reduction
+      to process independent factors concurrently. Results must not depend
+      on the number of threads.
+    */
+    utils::ThreadPool &get_thread_pool() const {
+        return *thread_pool;
+    }
+
     // Used by LabelReduction and MergeScoringFunctionDFP
     const task_representation::Labels &get_labels() const {
         return *labels;
@@ -1,5 +1,7 @@
 #include "label_map.h"
 
+#include "../utils/binary_io.h"
+
 #include <numeric>
 #include <iostream>
 #include <set>
@@ -12,6 +14,14 @@ LabelMap::LabelMap(int num_labels) {
     iota(reduced_labels.begin(), reduced_labels.end(), 0);
 }
 
+LabelMap::LabelMap(utils::BinaryReader &in)
+    : reduced_labels(in.read_ints()) {
+}
+
+void LabelMap::save(utils::BinaryWriter &out) const {
+    out.write_ints(reduced_labels);
+}
+
 void LabelMap::update(const LabelMapping &old_to_new_labels) {
     for (int &entry : reduced_labels) {
         if (old_to_new_labels[entry] != -1) {
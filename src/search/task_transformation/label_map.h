@@ -4,6 +4,11 @@
 #include <vector>
 #include <iostream>
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_transformation {
 
 
@@ -38,7 +43,10 @@ class LabelMap{
 //    std::vector<int> original_labels; // indexed by reduced label number
 public:
     explicit LabelMap(int num_labels);
+    explicit LabelMap(utils::BinaryReader &in);
     LabelMap(const LabelMap & ) = default;
+
+    void save(utils::BinaryWriter &out) const;
     
     void update(const LabelMapping &old_to_new_labels);
     void update(const std::vector<int> &old_to_new_labels);
@@ -18,6 +18,7 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <iostream>
@@ -147,6 +148,33 @@ equivalence_relation::EquivalenceRelation
     return relation;
 }
 
+vector<vector<pair<int, vector<int>>>> LabelReduction::compute_label_mappings(
+    const vector<int> &ts_indices,
+    const FactoredTransitionSystem &fts,
+    Verbosity verbosity) const {
+    vector<vector<pair<int, vector<int>>>> label_mappings(ts_indices.size());
+    fts.get_thread_pool().run(ts_indices.size(), [&](int i) {
+            if (fts.is_active(ts_indices[i])) {
+                equivalence_relation::EquivalenceRelation *relation =
+                    compute_combinable_equivalence_relation(ts_indices[i], fts);
+                compute_label_mapping(relation, fts, label_mappings[i], verbosity);
+                delete relation;
+            }
+        });
+    return label_mappings;
+}
+
+size_t LabelReduction::get_next_tso_index(
+    size_t tso_index, int num_transition_systems) const {
+    do {
+        ++tso_index;
+        if (tso_index == transition_system_order.size()) {
+            tso_index = 0;
+        }
+    } while (transition_system_order[tso_index] >= num_transition_systems);
+    return tso_index;
+}
+
 bool LabelReduction::reduce(
     const pair<int, int> &next_merge,
     FactoredTransitionSystem &fts,
@@ -213,6 +241,22 @@ bool LabelReduction::reduce(
 
     int num_unsuccessful_iterations = 0;
 
+    /*
+      The label mappings of the next transition systems in the order are
+      computed in batches, one transition system per thread. They remain
+      valid until a label mapping is applied, after which we discard the
+      rest of the batch. This yields the same result as computing them one
+      by one. We do not use batches in verbose mode, where computing a
+      label mapping may print output.
+    */
+    int batch_size = 1;
+    if (verbosity < Verbosity::VERBOSE) {
+        batch_size = fts.get_thread_pool().get_num_threads();
+    }
+    vector<int> batch_ts_indices;
+    vector<vector<pair<int, vector<int>>>> batch_label_mappings;
+    size_t batch_pos = 0;
+
     bool reduced = false;
     /*
       If using ALL_TRANSITION_SYSTEMS_WITH_FIXPOINT, this loop stops under
@@ -228,13 +272,22 @@ bool LabelReduction::reduce(
     for (int i = 0; i < max_iterations && timer() < max_time; ++i) {
         int ts_index = transition_system_order[tso_index];
 
-        vector<pair<int, vector<int>>> label_mapping;
-        if (fts.is_active(ts_index)) {
-            equivalence_relation::EquivalenceRelation *relation =
-                compute_combinable_equivalence_relation(ts_index, fts);
-            compute_label_mapping(relation, fts, label_mapping, verbosity);
-            delete relation;
+        if (batch_pos == batch_ts_indices.size()) {
+            batch_ts_indices.clear();
+            size_t next_tso_index = tso_index;
+            for (int j = 0; j < batch_size; ++j) {
+                batch_ts_indices.push_back(transition_system_order[next_tso_index]);
+                next_tso_index = get_next_tso_index(
+                    next_tso_index, num_transition_systems);
+            }
+            batch_label_mappings = compute_label_mappings(
+                batch_ts_indices, fts, verbosity);
+            batch_pos = 0;
         }
+        assert(batch_ts_indices[batch_pos] == ts_index);
+        vector<pair<int, vector<int>>> label_mapping =
+            move(batch_label_mappings[batch_pos]);
+        ++batch_pos;
 
         if (label_mapping.empty()) {
             /*
@@ -249,22 +302,15 @@ bool LabelReduction::reduce(
             // See comment for the loop and its exit conditions.
             num_unsuccessful_iterations = 1;
             fts.apply_label_mapping(label_mapping, ts_index);
+            // The remaining label mappings of the batch are outdated.
+            batch_pos = batch_ts_indices.size();
         }
         if (num_unsuccessful_iterations == num_transition_systems) {
             // See comment for the loop and its exit conditions.
             break;
         }
 
-        ++tso_index;
-        if (tso_index == transition_system_order.size()) {
-            tso_index = 0;
-        }
-        while (transition_system_order[tso_index] >= num_transition_systems) {
-            ++tso_index;
-            if (tso_index == transition_system_order.size()) {
-                tso_index = 0;
-            }
-        }
+        tso_index = get_next_tso_index(tso_index, num_transition_systems);
     }
 
     if (verbosity >= Verbosity::NORMAL && timer() > max_time ) {
@@ -79,6 +79,21 @@ class LabelReduction {
     *compute_combinable_equivalence_relation(
         int ts_index,
         const FactoredTransitionSystem &fts) const;
+
+    /*
+      Compute the label mappings for the given transition systems
+      independently of each other, i.e., each mapping is computed for the
+      current labels of fts. Transition systems are processed concurrently.
+    */
+    std::vector<std::vector<std::pair<int, std::vector<int>>>>
+    compute_label_mappings(
+        const std::vector<int> &ts_indices,
+        const FactoredTransitionSystem &fts,
+        Verbosity verbosity) const;
+
+    // Return the position in transition_system_order to consider after tso_index.
+    std::size_t get_next_tso_index(
+        std::size_t tso_index, int num_transition_systems) const;
 public:
     explicit LabelReduction(const options::Options &options);
     void initialize(const task_representation::FTSTask &fts_task);
@@ -25,6 +25,7 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <cassert>
@@ -68,6 +69,8 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(const Options &opts) :
         num_transitions_to_abort(opts.get<int>("num_transitions_to_abort")),
         num_transitions_to_exclude(opts.get<int>("num_transitions_to_exclude")),
         cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
+        num_threads(opts.get<int>("threads")),
+        compact_transitions(opts.get<bool>("compact_transitions")),
         starting_peak_memory(0) {
     assert(num_states_to_trigger_shrinking > 0);
     assert(max_states > 0);
@@ -116,6 +119,10 @@ void MergeAndShrinkAlgorithm::dump_options() const {
     }
     cout << endl;
 
+    cout << "Threads: " << num_threads << endl;
+    cout << "Compact transitions: " << (compact_transitions ? "yes" : "no") << endl;
+    cout << endl;
+
     cout << "Verbosity: ";
     switch (verbosity) {
     case Verbosity::SILENT:
@@ -633,6 +640,9 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
     for (int index = 0; index < num_vars; ++index) {
         transition_systems.push_back(
             utils::make_unique_ptr<TransitionSystem>(fts_task->get_ts(index), *labels));
+        if (compact_transitions) {
+            transition_systems.back()->set_compact_transitions(true);
+        }
     }
 
     std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> mas_representations =
@@ -659,7 +669,8 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
         compute_init_distances,
         compute_goal_distances,
         verbosity,
-        lossy_mapping);
+        lossy_mapping,
+        make_shared<utils::ThreadPool>(num_threads));
 
     bool unsolvable = prune_fts(fts, timer);
     if (unsolvable) {
@@ -688,6 +699,8 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
     }
 
 
+    Distances::release_workspace_memory();
+
     const bool final = true;
     report_peak_memory_delta(final);
     shrink_strategy = nullptr;
@@ -839,7 +852,23 @@ void add_merge_and_shrink_algorithm_options_to_parser(OptionParser &parser) {
         "further considerations of the algorithm.",
         "infinity",
         Bounds("0", "infinity"));
-
+    parser.add_option<int>(
+        "threads",
+        "Number of threads used to compute merge scores, distances, "
+        "bisimulations and label reductions of independent factors. The "
+        "result does not depend on the number of threads. Note that the "
+        "computation time (see max_time) is measured as the CPU time of all "
+        "threads.",
+        "1",
+        Bounds("1", "infinity"));
+    parser.add_option<bool>(
+        "compact_transitions",
+        "Store the transitions of all factors varint-encoded instead of as "
+        "pairs of ints. This typically needs a fraction of the memory for "
+        "large products, at the cost of slower merging, shrinking and "
+        "label reduction. Factors resulting from a merge inherit the "
+        "storage of their components.",
+        "false");
 }
 void add_transition_system_size_limit_options_to_parser(OptionParser &parser) {
     parser.add_option<int>(
@@ -69,6 +69,8 @@ class MergeAndShrinkAlgorithm {
     const int num_transitions_to_exclude;
 
     const OperatorCost cost_type;
+    const int num_threads;
+    const bool compact_transitions;
 
     //std::unique_ptr<task_transformation::LabelMap> label_map;
     long starting_peak_memory;
@@ -5,6 +5,8 @@
 
 #include "../task_representation/state.h"
 #include "../global_state.h"
+#include "../utils/binary_io.h"
+#include "../utils/memory.h"
 
 #include <algorithm>
 #include <iostream>
@@ -13,6 +15,10 @@
 using namespace std;
 
 namespace task_transformation {
+// Tags used by save and load to distinguish leaves from merges
+static const int LEAF_TAG = 0;
+static const int MERGE_TAG = 1;
+
 MergeAndShrinkRepresentation::MergeAndShrinkRepresentation(int domain_size)
     : domain_size(domain_size) {
 }
@@ -20,6 +26,18 @@ MergeAndShrinkRepresentation::MergeAndShrinkRepresentation(int domain_size)
 MergeAndShrinkRepresentation::~MergeAndShrinkRepresentation() {
 }
 
+unique_ptr<MergeAndShrinkRepresentation> MergeAndShrinkRepresentation::load(
+    utils::BinaryReader &in) {
+    int tag = in.read_int();
+    if (tag == LEAF_TAG) {
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationLeaf>(in);
+    } else if (tag == MERGE_TAG) {
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationMerge>(in);
+    }
+    throw utils::BinaryReadError(
+        "unknown merge-and-shrink representation " + to_string(tag));
+}
+
 int MergeAndShrinkRepresentation::get_domain_size() const {
     return domain_size;
 }
@@ -33,6 +51,20 @@ MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     iota(lookup_table.begin(), lookup_table.end(), 0);
 }
 
+MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
+    utils::BinaryReader &in)
+    : MergeAndShrinkRepresentation(in.read_int()),
+      var_id(in.read_int()),
+      lookup_table(in.read_ints()) {
+}
+
+void MergeAndShrinkRepresentationLeaf::save(utils::BinaryWriter &out) const {
+    out.write_int(LEAF_TAG);
+    out.write_int(domain_size);
+    out.write_int(var_id);
+    out.write_ints(lookup_table);
+}
+
 void MergeAndShrinkRepresentationLeaf::set_distances(
     const Distances &distances) {
     for (int &entry : lookup_table) {
@@ -69,6 +101,10 @@ int MergeAndShrinkRepresentationLeaf::get_value(const GlobalState &state) const
     return lookup_table[value];
 }
 
+void MergeAndShrinkRepresentationLeaf::get_variables(vector<int> &variables) const {
+    variables.push_back(var_id);
+}
+
 void MergeAndShrinkRepresentationLeaf::dump() const {
     for (const auto &value : lookup_table) {
         cout << value << ", ";
@@ -95,6 +131,29 @@ MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     }
 }
 
+MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
+    utils::BinaryReader &in)
+    : MergeAndShrinkRepresentation(in.read_int()),
+      left_child(load(in)),
+      right_child(load(in)) {
+    int num_rows = in.read_count();
+    lookup_table.reserve(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        lookup_table.push_back(in.read_ints());
+    }
+}
+
+void MergeAndShrinkRepresentationMerge::save(utils::BinaryWriter &out) const {
+    out.write_int(MERGE_TAG);
+    out.write_int(domain_size);
+    left_child->save(out);
+    right_child->save(out);
+    out.write_int(lookup_table.size());
+    for (const vector<int> &row : lookup_table) {
+        out.write_ints(row);
+    }
+}
+
 void MergeAndShrinkRepresentationMerge::set_distances(
     const Distances &distances) {
     for (vector<int> &row : lookup_table) {
@@ -150,6 +209,11 @@ int MergeAndShrinkRepresentationMerge::get_value(
     return lookup_table[state1][state2];
 }
 
+void MergeAndShrinkRepresentationMerge::get_variables(vector<int> &variables) const {
+    left_child->get_variables(variables);
+    right_child->get_variables(variables);
+}
+
 void MergeAndShrinkRepresentationMerge::dump() const {
     for (const auto &row : lookup_table) {
         for (const auto &value : row) {
@@ -10,6 +10,11 @@ class State;
 class GlobalState;
 using namespace task_representation;
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_transformation {
 class Distances;
 class MergeAndShrinkRepresentation {
@@ -20,6 +25,11 @@ public:
     explicit MergeAndShrinkRepresentation(int domain_size);
     virtual ~MergeAndShrinkRepresentation() = 0;
 
+    // Reads a representation (leaf or merge) written by save.
+    static std::unique_ptr<MergeAndShrinkRepresentation> load(
+        utils::BinaryReader &in);
+    virtual void save(utils::BinaryWriter &out) const = 0;
+
     // Store distances instead of abstract state numbers.
     virtual void set_distances(const Distances &) = 0;
     int get_domain_size() const;
@@ -31,6 +41,8 @@ public:
     virtual int get_value(const GlobalState &state) const = 0;
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) = 0;
+    // Append the variables the representation depends on.
+    virtual void get_variables(std::vector<int> &variables) const = 0;
     virtual void dump() const = 0;
 };
 
@@ -41,8 +53,11 @@ class MergeAndShrinkRepresentationLeaf : public MergeAndShrinkRepresentation {
     std::vector<int> lookup_table;
 public:
     MergeAndShrinkRepresentationLeaf(int var_id, int domain_size);
+    explicit MergeAndShrinkRepresentationLeaf(utils::BinaryReader &in);
     virtual ~MergeAndShrinkRepresentationLeaf() = default;
 
+    virtual void save(utils::BinaryWriter &out) const override;
+
     virtual void set_distances(const Distances &) override;
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
@@ -50,6 +65,7 @@ public:
     
     virtual int get_value(const State &state) const override;
     virtual int get_value(const GlobalState &state) const override;
+    virtual void get_variables(std::vector<int> &variables) const override;
     virtual void dump() const override;
 };
 
@@ -62,14 +78,18 @@ public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
         std::unique_ptr<MergeAndShrinkRepresentation> right_child);
+    explicit MergeAndShrinkRepresentationMerge(utils::BinaryReader &in);
     virtual ~MergeAndShrinkRepresentationMerge() = default;
 
+    virtual void save(utils::BinaryWriter &out) const override;
+
     virtual void set_distances(const Distances &distances) override;
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const std::vector<int> &state) const override;
     virtual int get_value(const State &state) const override;
     virtual int get_value(const GlobalState &state) const override;
+    virtual void get_variables(std::vector<int> &variables) const override;
     virtual void dump() const override;
 };
 }
@@ -26,7 +26,7 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
     for (const GroupAndTransitions &gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionList &transitions = gat.transitions;
         // Relevant labels with no transitions have a rank of infinity.
         int label_rank = INF;
         bool group_relevant = false;
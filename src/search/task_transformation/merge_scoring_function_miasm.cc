@@ -1,9 +1,9 @@
 #include "merge_scoring_function_miasm.h"
 
-#include "distances.h"
 #include "factored_transition_system.h"
 #include "merge_and_shrink_algorithm.h"
 #include "shrink_strategy.h"
+#include "virtual_product.h"
 #include "../task_representation/transition_system.h"
 #include "merge_scoring_function_miasm_utils.h"
 
@@ -12,6 +12,7 @@
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
 
 using namespace std;
 
@@ -27,12 +28,22 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
 vector<double> MergeScoringFunctionMIASM::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int index1 = merge_candidate.first;
-        int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+    /*
+      The products of all candidates are computed independently from each
+      other, which we distribute over the threads of the FTS. Shrinking a
+      factor may query any factor of the FTS (e.g., to find tau labels),
+      so we compute the lazily cached data of all factors beforehand.
+    */
+    for (int index = 0; index < fts.get_size(); ++index) {
+        if (fts.is_active(index)) {
+            fts.get_ts(index).compute_cached_data();
+        }
+    }
+    vector<double> scores(merge_candidates.size());
+    fts.get_thread_pool().run(merge_candidates.size(), [&](int candidate) {
+        int index1 = merge_candidates[candidate].first;
+        int index2 = merge_candidates[candidate].second;
+        unique_ptr<VirtualProduct> product = shrink_before_merge_externally(
             fts,
             index1,
             index2,
@@ -41,17 +52,17 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
             max_states_before_merge,
             shrink_threshold_before_merge);
 
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        const Verbosity verbosity = Verbosity::SILENT;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
+        /*
+          Compute distances for the product and count the alive states.
+          Only reachability matters here, so we ignore label costs.
+        */
+        vector<int> init_distances = product->compute_init_distances();
+        vector<int> goal_distances = product->compute_goal_distances();
         int num_states = product->get_size();
         int alive_states_count = 0;
         for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
+            if (init_distances[state] != INF &&
+                goal_distances[state] != INF) {
                 ++alive_states_count;
             }
         }
@@ -63,8 +74,8 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
         assert(num_states);
         double score = static_cast<double>(alive_states_count) /
             static_cast<double>(num_states);
-        scores.push_back(score);
-    }
+        scores[candidate] = score;
+    });
     return scores;
 }
 
@@ -3,8 +3,10 @@
 #include "distances.h"
 #include "factored_transition_system.h"
 #include "shrink_strategy.h"
+#include "../task_representation/label_equivalence_relation.h"
 #include "../task_representation/transition_system.h"
 #include "utils.h"
+#include "virtual_product.h"
 
 #include "../utils/memory.h"
 
@@ -56,7 +58,7 @@ unique_ptr<TransitionSystem> copy_and_shrink_ts(
     }
 }
 
-unique_ptr<TransitionSystem> shrink_before_merge_externally(
+unique_ptr<VirtualProduct> shrink_before_merge_externally(
     const FactoredTransitionSystem &fts,
     int index1,
     int index2,
@@ -103,12 +105,11 @@ unique_ptr<TransitionSystem> shrink_before_merge_externally(
 
     /*
       Return the product, using either the original transition systems or
-      the copied and shrunk ones.
+      the copied and shrunk ones. The product does not reference them, so
+      the copies can be released right away.
     */
-    return TransitionSystem::merge(
-        fts.get_labels(),
+    return utils::make_unique_ptr<VirtualProduct>(
         (ts1 ? *ts1 : original_ts1),
-        (ts2 ? *ts2 : original_ts2),
-        verbosity);
+        (ts2 ? *ts2 : original_ts2));
 }
 }
@@ -10,13 +10,14 @@ class TransitionSystem;
 namespace task_transformation {
 class FactoredTransitionSystem;
 class ShrinkStrategy;
+class VirtualProduct;
 
 /*
   Copy the two transition systems at the given indices, possibly shrink them
-  according to the same rules as merge-and-shrink does, and return their
-  product.
+  according to the same rules as merge-and-shrink does, and return a lazy
+  view of their product.
 */
-extern std::unique_ptr<task_representation::TransitionSystem> shrink_before_merge_externally(
+extern std::unique_ptr<VirtualProduct> shrink_before_merge_externally(
     const FactoredTransitionSystem &fts,
     int index1,
     int index2,
@@ -1,9 +1,30 @@
 #include "plan_reconstruction.h"
 
+#include "plan_reconstruction_merge_and_shrink.h"
+#include "plan_reconstruction_tau_path.h"
+#include "tau_graph.h"
+
+#include "../utils/binary_io.h"
+
 #include <algorithm>
 using namespace std;
 
 namespace task_transformation {
+shared_ptr<PlanReconstruction> PlanReconstruction::load(
+    utils::BinaryReader &in, const task_representation::Labels &labels) {
+    int tag = in.read_int();
+    switch (static_cast<PlanReconstructionTag>(tag)) {
+    case PlanReconstructionTag::SEQUENCE:
+        return PlanReconstructionSequence::load(in, labels);
+    case PlanReconstructionTag::MERGE_AND_SHRINK:
+        return PlanReconstructionMergeAndShrink::load(in);
+    case PlanReconstructionTag::TAU_PATH:
+        return PlanReconstructionTauPath::load(in, labels);
+    }
+    throw utils::BinaryReadError(
+        "unknown plan reconstruction " + to_string(tag));
+}
+
 PlanReconstructionSequence::PlanReconstructionSequence(
     vector<shared_ptr<PlanReconstruction>> plan_reconstructions_)
     : plan_reconstructions(plan_reconstructions_) {
@@ -11,6 +32,26 @@ PlanReconstructionSequence::PlanReconstructionSequence(
     std::reverse(plan_reconstructions.begin(), plan_reconstructions.end());
 }
 
+void PlanReconstructionSequence::save(utils::BinaryWriter &out) const {
+    out.write_int(static_cast<int>(PlanReconstructionTag::SEQUENCE));
+    out.write_int(plan_reconstructions.size());
+    for (const auto &pr : plan_reconstructions) {
+        pr->save(out);
+    }
+}
+
+shared_ptr<PlanReconstructionSequence> PlanReconstructionSequence::load(
+    utils::BinaryReader &in, const task_representation::Labels &labels) {
+    int num_plan_reconstructions = in.read_count();
+    vector<shared_ptr<PlanReconstruction>> plan_reconstructions;
+    for (int i = 0; i < num_plan_reconstructions; ++i) {
+        plan_reconstructions.push_back(PlanReconstruction::load(in, labels));
+    }
+    // The constructor reverses the steps again.
+    reverse(plan_reconstructions.begin(), plan_reconstructions.end());
+    return make_shared<PlanReconstructionSequence>(move(plan_reconstructions));
+}
+
     std::ostream& operator<<(std::ostream& o, const PlanReconstruction& b) {
         b.print(o);
         return o;
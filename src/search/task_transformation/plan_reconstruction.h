@@ -7,10 +7,23 @@
 
 namespace task_representation {
     class LabelID;
+    class Labels;
     class State;
 }
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
+
 namespace task_transformation {
+// Identifies the subclasses in files written by PlanReconstruction::save
+enum class PlanReconstructionTag {
+    SEQUENCE,
+    MERGE_AND_SHRINK,
+    TAU_PATH
+};
+
 class PlanReconstruction {
 public:
     virtual ~PlanReconstruction() = default;
@@ -19,6 +32,17 @@ public:
     virtual void reconstruct_plan(Plan & plan) const = 0;
     virtual void print(std::ostream& ) const { /* do your stuff */ }
 
+    // Writes a tag identifying the class followed by its data
+    virtual void save(utils::BinaryWriter &out) const = 0;
+
+    /*
+      Reads a plan reconstruction written by save. The transition systems
+      stored in tau path reconstructions refer to the given labels, which
+      should be the labels of the transformed task.
+    */
+    static std::shared_ptr<PlanReconstruction> load(
+        utils::BinaryReader &in, const task_representation::Labels &labels);
+
     friend std::ostream& operator<<(std::ostream& o, const PlanReconstruction& b);
 
 };
@@ -43,6 +67,10 @@ public:
             o << " ---> ";
         }
     }
+
+    virtual void save(utils::BinaryWriter &out) const override;
+    static std::shared_ptr<PlanReconstructionSequence> load(
+        utils::BinaryReader &in, const task_representation::Labels &labels);
 };
 }
 #endif
@@ -6,6 +6,7 @@
 #include "../task_representation/sas_task.h"
 #include "../task_representation/search_task.h"
 #include "../operator_id.h"
+#include "../utils/binary_io.h"
 #include "../utils/system.h"
 
 #include <iostream>
@@ -150,5 +151,28 @@ void PlanReconstructionMergeAndShrink::reconstruct_plan(Plan & plan) const {
         o << "MS";
     }
 
+void PlanReconstructionMergeAndShrink::save(utils::BinaryWriter &out) const {
+    out.write_int(static_cast<int>(PlanReconstructionTag::MERGE_AND_SHRINK));
+    predecessor_task->save(out);
+    out.write_int(merge_and_shrink_representations.size());
+    for (const auto &representation : merge_and_shrink_representations) {
+        representation->save(out);
+    }
+    label_map->save(out);
+}
+
+shared_ptr<PlanReconstructionMergeAndShrink> PlanReconstructionMergeAndShrink::load(
+    utils::BinaryReader &in) {
+    auto predecessor_task = make_shared<task_representation::FTSTask>(in);
+    int num_representations = in.read_count();
+    vector<unique_ptr<MergeAndShrinkRepresentation>> representations;
+    for (int i = 0; i < num_representations; ++i) {
+        representations.push_back(MergeAndShrinkRepresentation::load(in));
+    }
+    auto label_map = make_shared<LabelMap>(in);
+    return make_shared<PlanReconstructionMergeAndShrink>(
+        predecessor_task, move(representations), move(label_map));
+}
+
 
 }
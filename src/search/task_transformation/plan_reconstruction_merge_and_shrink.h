@@ -53,6 +53,10 @@ public:
     virtual void reconstruct_plan(Plan &plan) const override;
 
     virtual void print(std::ostream& o) const override;
+
+    virtual void save(utils::BinaryWriter &out) const override;
+    static std::shared_ptr<PlanReconstructionMergeAndShrink> load(
+        utils::BinaryReader &in);
 };
 }
 #endif
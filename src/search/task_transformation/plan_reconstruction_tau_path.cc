@@ -7,6 +7,8 @@
 #include "../task_representation/transition_system.h"
 #include "../task_representation/sas_task.h"
 #include "../task_representation/fact.h"
+#include "../utils/binary_io.h"
+#include "../utils/memory.h"
 
 using namespace task_representation;
 using namespace std;
@@ -245,4 +247,75 @@ void PlanReconstructionTauPath::reconstruct_plan(Plan &plan) const {
         o << "Tau";
     }
 
+void TauShrinking::save(utils::BinaryWriter &out) const {
+    out.write_int(ts_index_predecessor);
+    out.write_int(ts_index_successor);
+    tau_graph->save(out);
+    transition_system->save(out);
+    out.write_ints(abstraction);
+    out.write_ints(haslum_rule_center_state);
+}
+
+unique_ptr<TauShrinking> TauShrinking::load(
+    utils::BinaryReader &in, const task_representation::Labels &labels) {
+    int ts_index_predecessor = in.read_int();
+    int ts_index_successor = in.read_int();
+    auto tau_graph = utils::make_unique_ptr<TauGraph>(in);
+    auto transition_system = utils::make_unique_ptr<TransitionSystem>(in, labels);
+    vector<int> abstraction = in.read_ints();
+    vector<int> haslum_rule_center_state = in.read_ints();
+    return utils::make_unique_ptr<TauShrinking>(
+        ts_index_predecessor, ts_index_successor, move(tau_graph),
+        move(abstraction), move(transition_system), haslum_rule_center_state);
+}
+
+void PlanReconstructionTauPath::save(utils::BinaryWriter &out) const {
+    out.write_int(static_cast<int>(PlanReconstructionTag::TAU_PATH));
+    out.write_ints(initial_state.get_values());
+    out.write_int(tau_transformations.size());
+    for (const auto &tau_shrinking : tau_transformations) {
+        tau_shrinking->save(out);
+    }
+    out.write_ints(transition_system_mapping);
+
+    // Store the pointers as indices into tau_transformations (-1 for none)
+    vector<int> relevant_for_indices;
+    relevant_for_indices.reserve(label_only_relevant_for.size());
+    for (const TauShrinking *tau_shrinking : label_only_relevant_for) {
+        int index = -1;
+        for (size_t i = 0; i < tau_transformations.size(); ++i) {
+            if (tau_transformations[i].get() == tau_shrinking) {
+                index = i;
+                break;
+            }
+        }
+        relevant_for_indices.push_back(index);
+    }
+    out.write_ints(relevant_for_indices);
+}
+
+shared_ptr<PlanReconstructionTauPath> PlanReconstructionTauPath::load(
+    utils::BinaryReader &in, const task_representation::Labels &labels) {
+    PlanState initial_state(in.read_ints());
+    int num_tau_transformations = in.read_count();
+    vector<unique_ptr<TauShrinking>> tau_transformations;
+    for (int i = 0; i < num_tau_transformations; ++i) {
+        tau_transformations.push_back(TauShrinking::load(in, labels));
+    }
+    FTSMapping fts_mapping(in.read_ints(), vector<int>(), LabelMapping(vector<int>(), 0));
+
+    vector<TauShrinking *> label_only_relevant_for;
+    for (int index : in.read_ints()) {
+        if (index < -1 || index >= num_tau_transformations) {
+            throw utils::BinaryReadError(
+                "tau shrinking " + to_string(index) + " out of range");
+        }
+        label_only_relevant_for.push_back(
+            index == -1 ? nullptr : tau_transformations[index].get());
+    }
+    return make_shared<PlanReconstructionTauPath>(
+        fts_mapping, initial_state, move(tau_transformations),
+        move(label_only_relevant_for));
+}
+
 }
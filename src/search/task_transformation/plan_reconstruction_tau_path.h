@@ -9,6 +9,7 @@
 
 namespace task_representation {
 class FTSTask;
+class Labels;
 class TransitionSystem;
 }
 
@@ -94,6 +95,9 @@ public:
     void reconstruct_goal_step(std::vector<int> & new_label_path,
                                std::vector<PlanState> & new_traversed_states) const ;
 
+    void save(utils::BinaryWriter &out) const;
+    static std::unique_ptr<TauShrinking> load(
+        utils::BinaryReader &in, const task_representation::Labels &labels);
 };
 
 class PlanReconstructionTauPath : public PlanReconstruction {
@@ -116,6 +120,10 @@ PlanReconstructionTauPath(const FTSMapping & fts_mapping, PlanState initial_stat
     virtual void reconstruct_plan(Plan &plan) const override;
 
     virtual void print(std::ostream& o) const override;
+
+    virtual void save(utils::BinaryWriter &out) const override;
+    static std::shared_ptr<PlanReconstructionTauPath> load(
+        utils::BinaryReader &in, const task_representation::Labels &labels);
 };
 }
 #endif
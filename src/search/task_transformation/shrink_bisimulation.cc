@@ -1,5 +1,6 @@
 #include "shrink_bisimulation.h"
 
+#include "bisimulation_partition_refinement.h"
 #include "distances.h"
 #include "factored_transition_system.h"
 #include "../task_representation/label_equivalence_relation.h"
@@ -11,6 +12,7 @@
 #include "../utils/collections.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
@@ -97,6 +99,7 @@ ShrinkBisimulation::ShrinkBisimulation(const Options &opts)
     : ShrinkStrategy(),
       greedy(opts.get<bool>("greedy")),
       at_limit(AtLimit(opts.get_enum("at_limit"))),
+      algorithm(Algorithm(opts.get_enum("algorithm"))),
       max_size_after_shrink(opts.get<int>("max_size_after_shrink")),
       min_size_to_shrink(opts.get<int>("min_size_to_shrink")){
 }
@@ -139,6 +142,44 @@ int ShrinkBisimulation::initialize_groups(
     return num_groups;
 }
 
+bool ShrinkBisimulation::is_skipped_transition(
+    const Distances &distances,
+    const LabelGroup &label_group,
+    const Transition &transition) const {
+    if (!greedy) {
+        return false;
+    }
+    int src_h = distances.get_goal_distance(transition.src);
+    int target_h = distances.get_goal_distance(transition.target);
+    if (src_h == INF || target_h == INF) {
+        // We skip transitions connected to an irrelevant state.
+        return true;
+    }
+    int cost = label_group.get_cost();
+    assert(target_h + cost >= src_h);
+    return target_h + cost != src_h;
+}
+
+int ShrinkBisimulation::refine_by_partition_refinement(
+    const TransitionSystem &ts,
+    const Distances &distances,
+    vector<int> &state_to_group,
+    int num_groups) const {
+    vector<LabeledTransition> transitions;
+    int label_group_counter = 0;
+    for (const GroupAndTransitions &gat : ts) {
+        for (const Transition &transition : gat.transitions) {
+            if (!is_skipped_transition(distances, gat.label_group, transition)) {
+                transitions.emplace_back(
+                    label_group_counter, transition.src, transition.target);
+            }
+        }
+        ++label_group_counter;
+    }
+    return refine_to_coarsest_bisimulation(
+        ts.get_size(), transitions, state_to_group, num_groups);
+}
+
 void ShrinkBisimulation::compute_signatures(
     const TransitionSystem &ts,
     const Distances &distances,
@@ -188,23 +229,10 @@ void ShrinkBisimulation::compute_signatures(
     */
     for (const GroupAndTransitions &gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionList &transitions = gat.transitions;
         for (const Transition &transition : transitions) {
             assert(signatures[transition.src + 1].state == transition.src);
-            bool skip_transition = false;
-            if (greedy) {
-                int src_h = distances.get_goal_distance(transition.src);
-                int target_h = distances.get_goal_distance(transition.target);
-                if (src_h == INF || target_h == INF) {
-                    // We skip transitions connected to an irrelevant state.
-                    skip_transition = true;
-                } else {
-                    int cost = label_group.get_cost();
-                    assert(target_h + cost >= src_h);
-                    skip_transition = (target_h + cost != src_h);
-                }
-            }
-            if (!skip_transition) {
+            if (!is_skipped_transition(distances, label_group, transition)) {
                 int target_group = state_to_group[transition.target];
                 assert(target_group != -1 && target_group != SENTINEL);
                 signatures[transition.src + 1].succ_signature.push_back(
@@ -265,6 +293,23 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     // assert(num_groups <= target_size);
 
     bool stable = false;
+    if (algorithm == PARTITION_REFINEMENT) {
+        /*
+          Every partition computed in the rounds below is coarser than the
+          coarsest bisimulation, so if the latter respects the size limit,
+          it is also the result of the signature-based algorithm.
+          Otherwise, the result depends on the order of the splits, so we
+          fall back to the signature-based algorithm.
+        */
+        vector<int> refined_state_to_group(state_to_group);
+        int num_refined_groups = refine_by_partition_refinement(
+            ts, distances, refined_state_to_group, num_groups);
+        if (num_refined_groups <= target_size) {
+            state_to_group.swap(refined_state_to_group);
+            num_groups = num_refined_groups;
+            stable = true;
+        }
+    }
     bool stop_requested = false;
     while (!stable && !stop_requested && num_groups < target_size) {
         stable = true;
@@ -383,17 +428,30 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     
     bool ShrinkBisimulation::apply_shrinking_transformation(FactoredTransitionSystem &fts,
                                                 Verbosity verbosity) const  {
-        bool changes = false;
+        /*
+          The bisimulations of different factors are independent, so we
+          compute them concurrently and apply them in the order of the
+          factors afterwards.
+        */
+        vector<int> indices;
         for (int index = 0; index < fts.get_size(); ++index) {
-            if (fts.is_active(index)) {
-                if (fts.get_ts(index).get_size() < min_size_to_shrink) {
-                    continue;
-                }
-                StateEquivalenceRelation equivalence_relation =
-                    compute_equivalence_relation(fts, index, std::numeric_limits<int>::max());
-                changes |= fts.apply_abstraction(index, equivalence_relation, verbosity);
+            if (fts.is_active(index) &&
+                fts.get_ts(index).get_size() >= min_size_to_shrink) {
+                indices.push_back(index);
             }
         }
+        vector<StateEquivalenceRelation> equivalence_relations(indices.size());
+        fts.get_thread_pool().run(indices.size(), [&](int i) {
+                equivalence_relations[i] = compute_equivalence_relation(
+                    fts, indices[i], std::numeric_limits<int>::max());
+            });
+
+        bool changes = false;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            changes |= fts.apply_abstraction(
+                indices[i], equivalence_relations[i], verbosity);
+            utils::release_vector_memory(equivalence_relations[i]);
+        }
         return changes;
     }
 
@@ -404,6 +462,9 @@ string ShrinkBisimulation::name() const {
 
 void ShrinkBisimulation::dump_strategy_specific_options() const {
     cout << "Bisimulation type: " << (greedy ? "greedy" : "exact") << endl;
+    cout << "Algorithm: "
+         << (algorithm == SIGNATURES ? "signatures" : "partition refinement")
+         << endl;
     cout << "At limit: ";
     if (at_limit == RETURN) {
         cout << "return";
@@ -459,6 +520,23 @@ static shared_ptr<ShrinkStrategy>_parse(OptionParser &parser) {
         "at_limit", at_limit,
         "what to do when the size limit is hit", "RETURN");
 
+    vector<string> algorithm;
+    vector<string> algorithm_doc;
+    algorithm.push_back("SIGNATURES");
+    algorithm_doc.push_back(
+        "recompute the signatures of all states and sort them in every "
+        "refinement round");
+    algorithm.push_back("PARTITION_REFINEMENT");
+    algorithm_doc.push_back(
+        "partition refinement by Paige and Tarjan in O(m log n) time for m "
+        "transitions and n states. Computes the same partition as "
+        "SIGNATURES, but may number the abstract states differently. If the "
+        "coarsest bisimulation exceeds the size limit, SIGNATURES is used.");
+    parser.add_enum_option(
+        "algorithm", algorithm,
+        "algorithm for computing the bisimulation", "SIGNATURES",
+        algorithm_doc);
+
     parser.add_option<int>("max_size_after_shrink", "sets a maximum target size", "infinity");
 
     
@@ -482,6 +560,7 @@ static shared_ptr<ShrinkStrategy>_parse(OptionParser &parser) {
         Options opts; 
         opts.set<bool> ("greedy", false);
         opts.set<int>("at_limit", static_cast<int> (RETURN));
+        opts.set<int>("algorithm", static_cast<int> (SIGNATURES));
         opts.set<int>("max_size_after_shrink", std::numeric_limits<int>::max());
         opts.set<int>("min_size_to_shrink", 0);
 
@@ -7,7 +7,9 @@ namespace options {
 class Options;
 }
 namespace task_representation {
+    class LabelGroup;
     class TransitionSystem;
+    struct Transition;
 }
 
 namespace task_transformation {
@@ -21,8 +23,14 @@ class ShrinkBisimulation : public ShrinkStrategy {
         USE_UP
     };
 
+    enum Algorithm {
+        SIGNATURES,
+        PARTITION_REFINEMENT
+    };
+
     const bool greedy;
     const AtLimit at_limit;
+    const Algorithm algorithm;
     const int max_size_after_shrink;
     const int min_size_to_shrink;
 
@@ -38,6 +46,17 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const Distances &distances,
         std::vector<int> &state_to_group) const;
 
+    bool is_skipped_transition(
+        const Distances &distances,
+        const LabelGroup &label_group,
+        const Transition &transition) const;
+
+    int refine_by_partition_refinement(
+        const TransitionSystem &ts,
+        const Distances &distances,
+        std::vector<int> &state_to_group,
+        int num_groups) const;
+
     void compute_signatures(
         const TransitionSystem &ts,
         const Distances &distances,
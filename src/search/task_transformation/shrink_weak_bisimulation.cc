@@ -8,6 +8,7 @@
 #include "plan_reconstruction_tau_path.h"
 
 #include "tau_graph.h"
+#include "tau_reachability.h"
 #include "utils.h"
 
 #include "../option_parser.h"
@@ -15,6 +16,8 @@
 
 #include "../algorithms/sccs.h"
 
+#include "../utils/memory.h"
+
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -102,27 +105,6 @@ struct Signature {
     }
 
 
-    static void dfs_reachability(const vector<vector<int>> & tau_graph,
-                                 int i,
-                                 vector<vector<int>> & can_reach_via_tau_path){
-        if(!can_reach_via_tau_path[i].empty()) {
-            return;
-        }
-
-        can_reach_via_tau_path[i].push_back(i);
-
-        for (int predecessor : tau_graph[i]) {
-            dfs_reachability(tau_graph, predecessor, can_reach_via_tau_path);
-            for (int s : can_reach_via_tau_path[predecessor]) {
-                can_reach_via_tau_path[i].push_back(s);
-            }
-        }
-
-        ::sort(can_reach_via_tau_path[i].begin(), can_reach_via_tau_path[i].end());
-        vector<int>::iterator it = unique(can_reach_via_tau_path[i].begin(), can_reach_via_tau_path[i].end());
-        can_reach_via_tau_path[i].erase(it, can_reach_via_tau_path[i].end());
-    }
-
             /* remove duplicates in adjacency matrix */
 
     static void sort_unique (vector<vector<int>> & vs) {
@@ -135,6 +117,15 @@ struct Signature {
     StateEquivalenceRelation
     ShrinkWeakBisimulation::compute_equivalence_relation(const FactoredTransitionSystem &fts,
                                                          int index, int /*target*/) const {
+        vector<int> haslum_rule_center_state;
+        return compute_equivalence_relation(fts, index, haslum_rule_center_state);
+    }
+
+    StateEquivalenceRelation
+    ShrinkWeakBisimulation::compute_equivalence_relation(const FactoredTransitionSystem &fts,
+                                                         int index,
+                                                         vector<int> &haslum_rule_center_state) const {
+        haslum_rule_center_state.clear();
         //cout << "Equivalence relation for " << index << endl;
         const TransitionSystem &ts = fts.get_ts(index);
         //ts.dump_labels_and_transitions();
@@ -147,7 +138,7 @@ struct Signature {
         vector<vector<int>> tau_graph(num_states);
         int label_group_index = 0;
         for (const GroupAndTransitions &gat : ts) {
-            const vector<Transition> &transitions = gat.transitions;
+            const TransitionList &transitions = gat.transitions;
 
             bool is_tau = std::any_of(gat.label_group.begin(), gat.label_group.end(),
                                       [&](int label) {
@@ -200,7 +191,7 @@ struct Signature {
 
         vector<vector<int>> non_tau_scc_graph(num_sccs);
         for (const GroupAndTransitions &gat : ts) {
-            const vector<Transition> &transitions = gat.transitions;
+            const TransitionList &transitions = gat.transitions;
 
             bool is_tau = std::any_of(gat.label_group.begin(), gat.label_group.end(),
                                       [&](int label) {
@@ -254,20 +245,18 @@ struct Signature {
         }
 
         //Step 4: Compute can_reach_via_tau_path
-        vector<vector<int>> can_reach_via_tau_path(num_sccs);
-        for(int i = 0; i < num_sccs; ++i) {
-            dfs_reachability(tau_scc_graph, i, can_reach_via_tau_path);
-        }
+        TauReachability can_reach_via_tau_path(tau_scc_graph);
 
-
-        vector<vector<int>> can_be_reached_via_tau_path;
+        unique_ptr<TauReachability> can_be_reached_via_tau_path;
         if (coarsest) {
-            can_be_reached_via_tau_path.resize(num_sccs);
-            for(int i = 0; i < num_sccs; ++i) {
-                for (int j : can_reach_via_tau_path[i]){
-                    can_be_reached_via_tau_path[j].push_back(i);
+            vector<vector<int>> tau_scc_successors(num_sccs);
+            for (int i = 0; i < num_sccs; ++i) {
+                for (int j : tau_scc_graph[i]) {
+                    tau_scc_successors[j].push_back(i);
                 }
             }
+            can_be_reached_via_tau_path =
+                utils::make_unique_ptr<TauReachability>(tau_scc_successors);
         }
 
         //Step 5: Initialize Weak Bisimulations with the goal distances
@@ -283,7 +272,7 @@ struct Signature {
             stable = true;
 
             signatures.clear();
-            compute_signatures(ts, mapping_to_scc, goal_distances, tau_label_group, outside_relevant_group, signatures, scc_to_group, can_reach_via_tau_path, can_be_reached_via_tau_path);
+            compute_signatures(ts, mapping_to_scc, goal_distances, tau_label_group, outside_relevant_group, signatures, scc_to_group, can_reach_via_tau_path, can_be_reached_via_tau_path.get());
 
 
             // Verify size of signatures and presence of sentinels.
@@ -362,29 +351,41 @@ struct Signature {
         StateEquivalenceRelation equivalence_relation;
 
         if (apply_haslum_rule) {
-            haslum_rule_center_state.clear();
             int initial_state = ts.get_init_state();
             if (num_groups > 1 && goal_distances[mapping_to_scc[initial_state]] == 0) {
                 int center_state_group = -1;
                 int initial_state_group = scc_to_group[mapping_to_scc[initial_state]];
 
                 vector<int> goal_distances_groups (num_groups);
-                vector<vector<bool>> can_reach_via_tau_path_groups (num_groups);
-                for (int g = 0; g < num_groups; ++g) {
-                    can_reach_via_tau_path_groups[g].resize(num_groups, false);
-                }
+                vector<vector<int>> sccs_by_group (num_groups);
                 for(int i = 0; i < num_sccs; ++i) {
                     goal_distances_groups[scc_to_group[i]] = goal_distances[i];
-                    for(int j  : can_reach_via_tau_path[i]) {
-                        can_reach_via_tau_path_groups[scc_to_group[j]] [scc_to_group[i]] = true;
-                    }
-
-                    assert (can_reach_via_tau_path_groups[scc_to_group[i]] [scc_to_group[i]]);
+                    sccs_by_group[scc_to_group[i]].push_back(i);
                 }
 
+                // Groups that can reach the candidate group via tau paths
+                vector<bool> can_reach_candidate_group (num_groups, false);
+                vector<int> groups_reaching_candidate;
                 for (int candidate_group = 0; candidate_group < num_groups; ++candidate_group) {
-                    if (!can_reach_via_tau_path_groups[initial_state_group][candidate_group] ||
-                        goal_distances_groups[candidate_group] > 0) {
+                    if (goal_distances_groups[candidate_group] > 0) {
+                        continue;
+                    }
+
+                    for (int g : groups_reaching_candidate) {
+                        can_reach_candidate_group[g] = false;
+                    }
+                    groups_reaching_candidate.clear();
+                    for (int i : sccs_by_group[candidate_group]) {
+                        can_reach_via_tau_path.for_each_reaching(i, [&](int j) {
+                                int group = scc_to_group[j];
+                                if (!can_reach_candidate_group[group]) {
+                                    can_reach_candidate_group[group] = true;
+                                    groups_reaching_candidate.push_back(group);
+                                }
+                            });
+                    }
+                    assert(can_reach_candidate_group[candidate_group]);
+                    if (!can_reach_candidate_group[initial_state_group]) {
                         continue;
                     }
                             
@@ -392,11 +393,11 @@ struct Signature {
                     int label_group_counter = 0;
                     for (const GroupAndTransitions &gat : ts) {
                         if (outside_relevant_group [label_group_counter]) {
-                            const vector<Transition> &transitions = gat.transitions;
+                            const TransitionList &transitions = gat.transitions;
                             bool found = false;
                             for (const Transition &transition : transitions) {
                                 if (scc_to_group[mapping_to_scc[transition.src]] == candidate_group &&
-                                    can_reach_via_tau_path_groups[scc_to_group[mapping_to_scc[transition.target]]] [candidate_group]) {
+                                    can_reach_candidate_group[scc_to_group[mapping_to_scc[transition.target]]]) {
                                     found = true;
                                     break;
                                 }
@@ -421,7 +422,7 @@ struct Signature {
                 // int label_group_counter = 0;
                 // for (const GroupAndTransitions &gat : ts) {
                 //     if (outside_relevant_group [label_group_counter]) {
-                //         const vector<Transition> &transitions = gat.transitions;
+                //         const TransitionList &transitions = gat.transitions;
                 //         bool found = false;
                 //         for (const Transition &transition : transitions) {
                 //             if (scc_to_group[mapping_to_scc[transition.src]] == initial_state_group &&
@@ -445,7 +446,7 @@ struct Signature {
                     cout << "Variable abstracted by Haslum's rule." << endl;
                     equivalence_relation.resize(1);
                     for (int state = 0; state < num_states; ++state) {
-                        if (can_reach_via_tau_path_groups[scc_to_group[mapping_to_scc[state]]][center_state_group]) {
+                        if (can_reach_candidate_group[scc_to_group[mapping_to_scc[state]]]) {
                             haslum_rule_center_state.push_back(state);
                         }
                         equivalence_relation[0].push_front(state);
@@ -505,8 +506,8 @@ struct Signature {
         const vector<bool> &outside_relevant_group,
         vector<Signature> &signatures,
         const vector<int> &state_to_group,
-        const vector<vector<int>> &can_reach_via_tau_path,
-        const vector<vector<int>> & can_be_reached_via_tau_path) const {
+        const TauReachability &can_reach_via_tau_path,
+        const TauReachability *can_be_reached_via_tau_path) const {
         assert(signatures.empty());
 
         // Step 1: Compute bare state signatures (without transition information).
@@ -526,17 +527,14 @@ struct Signature {
             if (!ignore_irrelevant_tau_groups ||
                 !tau_label_group[label_group_counter]
                 || outside_relevant_group [label_group_counter]) {
-                const vector<Transition> &transitions = gat.transitions;
+                const TransitionList &transitions = gat.transitions;
                 for (const Transition &transition : transitions) {
                     int transition_src = mapping_to_scc[transition.src];
                     int transition_target = mapping_to_scc[transition.target];
 
                     if (ignore_irrelevant_tau_groups &&
                         !outside_relevant_group[label_group_counter] &&
-                        std::find(can_reach_via_tau_path[transition_target].begin(),
-                                  can_reach_via_tau_path[transition_target].end(),
-                                  transition_src)
-                        != can_reach_via_tau_path[transition_target].end()){
+                        can_reach_via_tau_path.can_reach(transition_src, transition_target)){
                         continue;
                     }
                     assert(signatures[transition_src + 1].state == transition_src);
@@ -544,22 +542,21 @@ struct Signature {
                     int target_group = state_to_group[transition_target];
                     assert(target_group != -1 && target_group != SENTINEL);
 
-                    for (int src_state : can_reach_via_tau_path[transition_src]) {
+                    can_reach_via_tau_path.for_each_reaching(transition_src, [&](int src_state) {
                         assert (src_state >= 0);
                         assert (src_state < (int)(goal_distances.size()));
                         assert(signatures[src_state + 1].state == src_state);
 
-                        if(can_be_reached_via_tau_path.empty()) {
+                        if(!can_be_reached_via_tau_path) {
                             signatures[src_state + 1].succ_signature.push_back(
                                 make_pair(label_group_counter, target_group));
                         } else {
-                            for (int target : can_be_reached_via_tau_path[transition_target]) {
+                            can_be_reached_via_tau_path->for_each_reaching(transition_target, [&](int target) {
                                 signatures[src_state + 1].succ_signature.push_back(
                                     make_pair(label_group_counter, state_to_group[target]));
-
-                            }
+                            });
                         }
-                    }
+                    });
                 }
             }
             ++label_group_counter;
@@ -615,7 +612,9 @@ struct Signature {
                 initial_state_values.push_back(fts.get_ts(index).get_init_state());
 
                 if (check_only_index == -1 || index == check_only_index) {
-                    equivalences[new_index] = compute_equivalence_relation(fts, index, 0);
+                    vector<int> haslum_rule_center_state;
+                    equivalences[new_index] = compute_equivalence_relation(
+                        fts, index, haslum_rule_center_state);
                     assert(equivalences[new_index].size() > 0);
 
                     size_t old_size = fts.get_ts(index).get_size();
@@ -16,14 +16,22 @@ namespace task_representation {
 
 namespace task_transformation {
     struct Signature;
+    class TauReachability;
     class ShrinkWeakBisimulation : public ShrinkStrategy {
         const bool preserve_optimality;
         const bool ignore_irrelevant_tau_groups;
         const bool apply_haslum_rule;
         const bool coarsest;
 
-
-        mutable std::vector<int> haslum_rule_center_state;
+        /*
+          Like the public overload, but also store the states mapped to the
+          center state if the transition system is abstracted away by
+          Haslum's rule (and clear haslum_rule_center_state otherwise).
+        */
+        StateEquivalenceRelation compute_equivalence_relation(
+            const FactoredTransitionSystem &fts,
+            int index,
+            std::vector<int> &haslum_rule_center_state) const;
 
         int initialize_groups(
             const std::vector<int> & goal_distances,
@@ -37,8 +45,8 @@ namespace task_transformation {
         const std::vector<bool> & outside_relevant_group,
         std::vector<Signature> &signatures,
         const std::vector<int> &state_to_group,
-        const std::vector<std::vector<int>> &can_reach_via_tau_path, 
-        const std::vector<std::vector<int>> &can_be_reached_via_tau_path) const;
+        const TauReachability &can_reach_via_tau_path,
+        const TauReachability *can_be_reached_via_tau_path) const;
 
     public:
         ShrinkWeakBisimulation(const options::Options &opts);
@@ -1,6 +1,8 @@
 #include "state_mapping.h"
 #include "merge_and_shrink_representation.h"
 
+#include <cassert>
+
 using namespace std;
 namespace task_transformation {
     
@@ -10,18 +12,39 @@ namespace task_transformation {
 
 
     std::vector<int> StateMapping::convert_state(const GlobalState & state) const {
-        vector<int> values(merge_and_shrink_representations.size());
+        vector<int> values;
+        convert_state(state, values);
+        return values;
+    }
+
+    void StateMapping::convert_state(const GlobalState & state, vector<int> & values) const {
+        values.resize(merge_and_shrink_representations.size());
         for (size_t var = 0; var < merge_and_shrink_representations.size(); ++var) {
             values[var] =  merge_and_shrink_representations[var]->get_value(state);
             if (values[var] == -1) {
                 values.clear(); //dead end states are represented by an empty vector
-                return values;
+                return;
             }
         }
-        return values;
     }
 
     int StateMapping::get_value_abstract_variable(const std::vector<int> & state, int var) const {
         return merge_and_shrink_representations[var]->get_value(state);
     }
+
+    vector<int> StateMapping::get_abstract_variable_by_variable(int num_variables) const {
+        vector<int> abstract_var_by_var(num_variables, -1);
+        vector<int> variables;
+        for (size_t abstract_var = 0;
+             abstract_var < merge_and_shrink_representations.size(); ++abstract_var) {
+            variables.clear();
+            merge_and_shrink_representations[abstract_var]->get_variables(variables);
+            for (int var : variables) {
+                // The factors of a merge-and-shrink abstraction are disjoint.
+                assert(abstract_var_by_var[var] == -1);
+                abstract_var_by_var[var] = abstract_var;
+            }
+        }
+        return abstract_var_by_var;
+    }
 }
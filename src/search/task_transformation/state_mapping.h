@@ -18,7 +18,16 @@ public:
     StateMapping(std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> && merge_and_shrink_representations_) ;
 
     std::vector<int> convert_state(const GlobalState & state) const;
+    // Store the result in the given vector, reusing its memory.
+    void convert_state(const GlobalState & state, std::vector<int> & values) const;
     int get_value_abstract_variable(const std::vector<int> & state, int var) const;
+
+    int get_num_abstract_variables() const {
+        return merge_and_shrink_representations.size();
+    }
+    // Abstract variable depending on each of the num_variables variables
+    // (-1 for variables no abstract variable depends on).
+    std::vector<int> get_abstract_variable_by_variable(int num_variables) const;
     
 };
 
@@ -7,6 +7,7 @@
 #include "../algorithms/sccs.h"
 #include "../algorithms/priority_queues.h"
 
+#include "../utils/binary_io.h"
 #include "../utils/system.h"
 
 #include <algorithm>
@@ -75,6 +76,35 @@ namespace task_transformation {
 
 
 
+    TauGraph::TauGraph(utils::BinaryReader &in) {
+        int num_states = in.read_count();
+        adjacency_matrix.resize(num_states);
+        for (auto &row : adjacency_matrix) {
+            vector<int> flat_row = in.read_ints();
+            row.reserve(flat_row.size() / 3);
+            for (size_t i = 0; i + 2 < flat_row.size(); i += 3) {
+                row.emplace_back(flat_row[i], LabelID(flat_row[i + 1]),
+                                 flat_row[i + 2]);
+            }
+        }
+        is_goal = in.read_bools();
+    }
+
+    void TauGraph::save(utils::BinaryWriter &out) const {
+        out.write_int(adjacency_matrix.size());
+        for (const auto &row : adjacency_matrix) {
+            vector<int> flat_row;
+            flat_row.reserve(3 * row.size());
+            for (const TauTransition &transition : row) {
+                flat_row.push_back(transition.target);
+                flat_row.push_back(transition.label);
+                flat_row.push_back(transition.cost);
+            }
+            out.write_ints(flat_row);
+        }
+        out.write_bools(is_goal);
+    }
+
     void TauGraph::apply_label_mapping(const LabelMapping & label_mapping) {
         for ( auto & row : adjacency_matrix){
             for (auto & item : row) {
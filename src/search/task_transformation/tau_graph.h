@@ -7,6 +7,10 @@
 
 #include <vector>
 
+namespace utils {
+class BinaryReader;
+class BinaryWriter;
+}
 
 namespace task_transformation {
 /* class LabelMap; */
@@ -35,6 +39,9 @@ namespace task_transformation {
     public:
 
         TauGraph(const FactoredTransitionSystem &fts, int index, bool preserve_optimality);
+        explicit TauGraph(utils::BinaryReader &in);
+
+        void save(utils::BinaryWriter &out) const;
 
         StateEquivalenceRelation compute_own_label_shrinking();
         StateEquivalenceRelation compute_own_label_plus_sg_shrinking(const FactoredTransitionSystem &fts, int index);
@@ -0,0 +1,127 @@
+#include "tau_reachability.h"
+
+#include "../utils/collections.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace task_transformation {
+const int TauReachability::lowest_bit_table[64] = {
+    0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+    62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+    63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+    46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+};
+
+TauReachability::TauReachability(const vector<vector<int>> &predecessors) {
+    int num_nodes = predecessors.size();
+
+    // Topological order by Kahn's algorithm
+    vector<int> successor_begin(num_nodes + 1, 0);
+    vector<int> num_unordered_predecessors(num_nodes);
+    for (int node = 0; node < num_nodes; ++node) {
+        for (int pred : predecessors[node]) {
+            if (pred != node) {
+                ++num_unordered_predecessors[node];
+                ++successor_begin[pred + 1];
+            }
+        }
+    }
+    for (int node = 0; node < num_nodes; ++node) {
+        successor_begin[node + 1] += successor_begin[node];
+    }
+    vector<int> successors(successor_begin[num_nodes]);
+    {
+        vector<int> next(successor_begin.begin(), successor_begin.end() - 1);
+        for (int node = 0; node < num_nodes; ++node) {
+            for (int pred : predecessors[node]) {
+                if (pred != node) {
+                    successors[next[pred]++] = node;
+                }
+            }
+        }
+    }
+    node_at.reserve(num_nodes);
+    for (int node = 0; node < num_nodes; ++node) {
+        if (num_unordered_predecessors[node] == 0) {
+            node_at.push_back(node);
+        }
+    }
+    for (size_t i = 0; i < node_at.size(); ++i) {
+        int node = node_at[i];
+        for (int j = successor_begin[node]; j < successor_begin[node + 1]; ++j) {
+            if (--num_unordered_predecessors[successors[j]] == 0) {
+                node_at.push_back(successors[j]);
+            }
+        }
+    }
+    // Fails if the graph has cycles other than self-loops.
+    assert(static_cast<int>(node_at.size()) == num_nodes);
+    position.resize(num_nodes);
+    for (int pos = 0; pos < num_nodes; ++pos) {
+        position[node_at[pos]] = pos;
+    }
+    utils::release_vector_memory(successors);
+    utils::release_vector_memory(successor_begin);
+
+    // Determine the range of words of each bitset.
+    first_word.resize(num_nodes);
+    offset.resize(num_nodes + 1);
+    offset[0] = 0;
+    for (int node : node_at) {
+        int first = position[node] >> 6;
+        for (int pred : predecessors[node]) {
+            if (pred != node) {
+                first = min(first, first_word[pred]);
+            }
+        }
+        first_word[node] = first;
+    }
+    for (int node = 0; node < num_nodes; ++node) {
+        offset[node + 1] = offset[node] + (position[node] >> 6) - first_word[node] + 1;
+    }
+    words.resize(offset[num_nodes], 0);
+
+    // A node is saturated if all nodes before it can reach it.
+    vector<bool> saturated(num_nodes, false);
+    vector<int> sorted_predecessors;
+    for (int node : node_at) {
+        uint64_t *row = &words[offset[node]];
+        int pos = position[node];
+        row[(pos >> 6) - first_word[node]] |= uint64_t(1) << (pos & 63);
+
+        sorted_predecessors = predecessors[node];
+        sort(sorted_predecessors.begin(), sorted_predecessors.end(),
+             [&](int lhs, int rhs) {
+                 return position[lhs] > position[rhs];
+             });
+        for (int pred : sorted_predecessors) {
+            if (pred == node) {
+                continue;
+            }
+            const uint64_t *pred_row = &words[offset[pred]];
+            int shift = first_word[pred] - first_word[node];
+            for (int word = 0; word < get_num_words(pred); ++word) {
+                row[shift + word] |= pred_row[word];
+            }
+            if (saturated[pred]) {
+                // The remaining predecessors come before pred.
+                break;
+            }
+        }
+
+        if (first_word[node] == 0) {
+            bool full = true;
+            int num_full_words = pos >> 6;
+            for (int word = 0; word < num_full_words && full; ++word) {
+                full = row[word] == ~uint64_t(0);
+            }
+            uint64_t last_word_mask = (pos & 63) == 63 ?
+                ~uint64_t(0) : (uint64_t(1) << ((pos & 63) + 1)) - 1;
+            saturated[node] = full && row[num_full_words] == last_word_mask;
+        }
+    }
+}
+}
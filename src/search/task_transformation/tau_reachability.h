@@ -0,0 +1,76 @@
+#ifndef TASK_TRANSFORMATION_TAU_REACHABILITY_H
+#define TASK_TRANSFORMATION_TAU_REACHABILITY_H
+
+#include <cstdint>
+#include <vector>
+
+namespace task_transformation {
+/*
+  Reflexive transitive closure of an acyclic graph, e.g. the tau
+  transitions between the SCCs of a transition system, given by the
+  predecessors of each node. Self-loops are ignored.
+
+  Nodes are numbered in a topological order and the set of nodes that can
+  reach a node is a bitset over these numbers. As a node can only be
+  reached from nodes with smaller numbers, the bitset of a node is stored
+  from the first non-zero 64-bit word up to the word of the node itself.
+  The bitsets are computed in topological order as the union of the
+  bitsets of the predecessors. Once the bitset of a predecessor contains
+  all nodes with smaller numbers, the remaining predecessors add nothing
+  and are skipped.
+*/
+class TauReachability {
+    // Position of each node in the topological order and vice versa
+    std::vector<int> position;
+    std::vector<int> node_at;
+
+    // The bitset of a node is words[offset[node] ... offset[node + 1])
+    // and starts with the bit of position 64 * first_word[node].
+    std::vector<std::size_t> offset;
+    std::vector<int> first_word;
+    std::vector<std::uint64_t> words;
+
+    int get_num_words(int node) const {
+        return offset[node + 1] - offset[node];
+    }
+
+    // Index of the lowest set bit by de Bruijn multiplication
+    static const int lowest_bit_table[64];
+    static int get_lowest_bit(std::uint64_t bits) {
+        return lowest_bit_table[
+            ((bits & (~bits + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+    }
+public:
+    explicit TauReachability(const std::vector<std::vector<int>> &predecessors);
+
+    // Return true if there is a path (possibly empty) from node from to node to.
+    bool can_reach(int from, int to) const {
+        int word = (position[from] >> 6) - first_word[to];
+        if (word < 0 || word >= get_num_words(to)) {
+            return false;
+        }
+        return (words[offset[to] + word] >> (position[from] & 63)) & 1;
+    }
+
+    // Call f(node) for every node that can reach node to, including to.
+    template<typename Callback>
+    void for_each_reaching(int to, Callback f) const {
+        const std::uint64_t *row = &words[offset[to]];
+        int num_words = get_num_words(to);
+        for (int word = 0; word < num_words; ++word) {
+            std::uint64_t bits = row[word];
+            while (bits) {
+                int bit = get_lowest_bit(bits);
+                bits &= bits - 1;
+                f(node_at[((first_word[to] + word) << 6) + bit]);
+            }
+        }
+    }
+
+    std::size_t get_num_words() const {
+        return words.size();
+    }
+};
+}
+
+#endif
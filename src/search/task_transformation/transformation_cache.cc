@@ -0,0 +1,133 @@
+#include "transformation_cache.h"
+
+#include "plan_reconstruction.h"
+
+#include "../task_representation/fts_task.h"
+#include "../task_representation/labels.h"
+
+#include "../utils/binary_io.h"
+#include "../utils/hash.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using task_representation::FTSTask;
+
+namespace task_transformation {
+static const string MAGIC = "FTSCACHE";
+// Increase whenever the serialization of any of the stored classes changes.
+static const int VERSION = 2;
+
+static void feed_bytes(utils::HashState &hash_state, const string &data) {
+    utils::feed(hash_state, static_cast<uint64_t>(data.size()));
+    for (size_t i = 0; i < data.size(); i += 4) {
+        uint32_t word = 0;
+        for (size_t j = i; j < min(i + 4, data.size()); ++j) {
+            word = (word << 8) | static_cast<unsigned char>(data[j]);
+        }
+        hash_state.feed(word);
+    }
+}
+
+TransformationCache::TransformationCache(
+    const string &directory, const FTSTask &task, const string &transform_config)
+    : transform_config(transform_config) {
+    utils::BinaryWriter writer;
+    task.save(writer);
+    source_task_data = writer.get_data();
+    utils::HashState hash_state;
+    feed_bytes(hash_state, source_task_data);
+    feed_bytes(hash_state, transform_config);
+    task_hash = hash_state.get_hash64();
+
+    ostringstream name;
+    name << directory << "/" << hex << setw(16) << setfill('0') << task_hash
+         << ".fts";
+    filename = name.str();
+}
+
+pair<shared_ptr<FTSTask>, shared_ptr<PlanReconstruction>>
+TransformationCache::load() const {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        cout << "No cached transformation in " << filename << endl;
+        return make_pair(nullptr, nullptr);
+    }
+    ostringstream contents;
+    contents << file.rdbuf();
+    utils::BinaryReader reader(contents.str());
+
+    try {
+        if (reader.read_string() != MAGIC || reader.read_int() != VERSION) {
+            cout << "Ignoring cached transformation in " << filename
+                 << " written by another version" << endl;
+            return make_pair(nullptr, nullptr);
+        }
+        uint64_t low = static_cast<uint32_t>(reader.read_int());
+        uint64_t high = static_cast<uint32_t>(reader.read_int());
+        // Tasks or configurations with the same hash differ here.
+        if (((high << 32) | low) != task_hash ||
+            reader.read_string() != transform_config ||
+            reader.read_string() != source_task_data) {
+            cout << "Ignoring cached transformation in " << filename
+                 << " of another task or transformation" << endl;
+            return make_pair(nullptr, nullptr);
+        }
+        shared_ptr<FTSTask> task = make_shared<FTSTask>(reader);
+        shared_ptr<PlanReconstruction> plan_reconstruction =
+            PlanReconstruction::load(reader, task->get_labels());
+        if (!reader.at_end()) {
+            throw utils::BinaryReadError("trailing data");
+        }
+        cout << "Loaded cached transformation from " << filename << endl;
+        return make_pair(task, plan_reconstruction);
+    } catch (const utils::BinaryReadError &error) {
+        cout << "Ignoring corrupt cached transformation in " << filename
+             << ": " << error.msg << endl;
+        return make_pair(nullptr, nullptr);
+    }
+}
+
+void TransformationCache::save(
+    const FTSTask &task, const PlanReconstruction &plan_reconstruction) const {
+    utils::BinaryWriter writer;
+    writer.write_string(MAGIC);
+    writer.write_int(VERSION);
+    writer.write_int(static_cast<uint32_t>(task_hash));
+    writer.write_int(static_cast<uint32_t>(task_hash >> 32));
+    writer.write_string(transform_config);
+    writer.write_string(source_task_data);
+    task.save(writer);
+    plan_reconstruction.save(writer);
+
+    /*
+      Write to a temporary file first so that concurrent or aborted runs
+      never leave a partial cache file behind.
+    */
+    string tmp_filename = filename + ".tmp" + to_string(utils::get_process_id());
+    {
+        ofstream file(tmp_filename, ios::binary);
+        file.write(writer.get_data().data(), writer.get_data().size());
+        file.close();
+        if (!file) {
+            cout << "Could not write cached transformation to "
+                 << tmp_filename << endl;
+            remove(tmp_filename.c_str());
+            return;
+        }
+    }
+    if (rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        cout << "Could not write cached transformation to " << filename << endl;
+        remove(tmp_filename.c_str());
+        return;
+    }
+    cout << "Saved transformation (" << writer.get_data().size()
+         << " bytes) to " << filename << endl;
+}
+}
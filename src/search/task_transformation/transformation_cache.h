@@ -0,0 +1,49 @@
+#ifndef TASK_TRANSFORMATION_TRANSFORMATION_CACHE_H
+#define TASK_TRANSFORMATION_TRANSFORMATION_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace task_representation {
+class FTSTask;
+}
+
+namespace task_transformation {
+class PlanReconstruction;
+
+/*
+  Stores the result of a task transformation, i.e., the transformed task
+  and its plan reconstruction, in a binary file, so that later runs on the
+  same task with the same transformation (e.g. further configurations of a
+  portfolio) can load it instead of transforming the task again.
+
+  The file name is a hash of the serialized input task and of the
+  transformation configuration. The file also contains the hash, the
+  configuration and the serialized input task, which are all compared when
+  loading it, so a hash collision cannot load the result of another task.
+*/
+class TransformationCache {
+    std::uint64_t task_hash;
+    std::string transform_config;
+    std::string source_task_data;
+    std::string filename;
+public:
+    TransformationCache(const std::string &directory,
+                        const task_representation::FTSTask &task,
+                        const std::string &transform_config);
+
+    /*
+      Returns the cached transformation or a pair of null pointers if there
+      is no valid cache file.
+    */
+    std::pair<std::shared_ptr<task_representation::FTSTask>,
+              std::shared_ptr<PlanReconstruction>> load() const;
+
+    void save(const task_representation::FTSTask &task,
+              const PlanReconstruction &plan_reconstruction) const;
+};
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include "virtual_product.h"
+
+#include "types.h"
+
+using namespace std;
+
+namespace task_transformation {
+void VirtualProduct::breadth_first_search(
+    const ComponentGraph &graph1, const ComponentGraph &graph2,
+    vector<int> &queue, vector<int> &distances) const {
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        int successor_distance = distances[state] + 1;
+        for_each_neighbor(graph1, graph2, state, [&](int, int successor) {
+            if (distances[successor] > successor_distance) {
+                distances[successor] = successor_distance;
+                queue.push_back(successor);
+            }
+        });
+    }
+}
+
+vector<int> VirtualProduct::compute_init_distances() const {
+    vector<int> distances(get_size(), INF);
+    distances[init_state] = 0;
+    vector<int> queue(1, init_state);
+    breadth_first_search(forward1, forward2, queue, distances);
+    return distances;
+}
+
+vector<int> VirtualProduct::compute_goal_distances() const {
+    vector<int> distances(get_size(), INF);
+    for (int goal_state : goal_states) {
+        distances[goal_state] = 0;
+    }
+    vector<int> queue(goal_states);
+    breadth_first_search(backward1, backward2, queue, distances);
+    return distances;
+}
+}
@@ -0,0 +1,230 @@
+#ifndef TASK_TRANSFORMATION_VIRTUAL_PRODUCT_H
+#define TASK_TRANSFORMATION_VIRTUAL_PRODUCT_H
+
+#include "types.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace task_transformation {
+/*
+  A lazy view on the product of two transition systems, for scoring merge
+  candidates without computing the product with TransitionSystem::merge.
+  The constructor is a template so that the same view serves both the
+  transition systems of task_representation and those of the
+  merge_and_shrink heuristic. It only uses the interface they share.
+
+  States are numbered as in TransitionSystem::merge, i.e. the product
+  state of s1 and s2 is s1 * size2 + s2. The label groups of the product
+  are the non-empty intersections of a label group of each component, as
+  in TransitionSystem::merge, but the numbering of groups differs.
+
+  The view only stores the transitions of both components, indexed by
+  source and by target, and enumerates the product transitions of a
+  state on demand. It thus needs memory linear in the size of the
+  components, plus whatever the caller allocates per product state. The
+  view does not reference the components after construction.
+*/
+class VirtualProduct {
+    // The transitions of a component indexed by state, ordered by group.
+    struct ComponentGraph {
+        std::vector<int> state_first_arc;
+        // Pairs of (component label group, other end of the transition).
+        std::vector<std::pair<int, int>> arcs;
+    };
+
+    int size1;
+    int size2;
+    int init_state;
+    std::vector<int> goal_states;
+    int num_label_groups;
+    /*
+      For every label group of the first component, the label groups of
+      the second component that it intersects with, as pairs of (group of
+      the second component, product group), ordered by the former.
+    */
+    std::vector<std::vector<std::pair<int, int>>> product_groups_by_group1;
+    ComponentGraph forward1;
+    ComponentGraph backward1;
+    ComponentGraph forward2;
+    ComponentGraph backward2;
+
+    template<class Callback>
+    void for_each_neighbor(const ComponentGraph &graph1,
+                           const ComponentGraph &graph2,
+                           int state,
+                           const Callback &callback) const {
+        int s1 = state / size2;
+        int s2 = state % size2;
+        auto arcs2_begin = graph2.arcs.begin() + graph2.state_first_arc[s2];
+        auto arcs2_end = graph2.arcs.begin() + graph2.state_first_arc[s2 + 1];
+        if (arcs2_begin == arcs2_end)
+            return;
+        auto arcs1_end = graph1.arcs.begin() + graph1.state_first_arc[s1 + 1];
+        auto run1_begin = graph1.arcs.begin() + graph1.state_first_arc[s1];
+        while (run1_begin != arcs1_end) {
+            // Arcs of s1 with the same group form a run.
+            int group1 = run1_begin->first;
+            auto run1_end = run1_begin;
+            while (run1_end != arcs1_end && run1_end->first == group1)
+                ++run1_end;
+            auto run2_begin = arcs2_begin;
+            for (const std::pair<int, int> &product_group :
+                 product_groups_by_group1[group1]) {
+                int group2 = product_group.first;
+                run2_begin = std::lower_bound(
+                    run2_begin, arcs2_end, std::make_pair(group2, 0));
+                for (auto arc2 = run2_begin;
+                     arc2 != arcs2_end && arc2->first == group2; ++arc2) {
+                    for (auto arc1 = run1_begin; arc1 != run1_end; ++arc1) {
+                        callback(product_group.second,
+                                 arc1->second * size2 + arc2->second);
+                    }
+                }
+            }
+            run1_begin = run1_end;
+        }
+    }
+
+    template<class TransitionSystem>
+    static void build_graph(const TransitionSystem &ts, bool backward,
+                            ComponentGraph &graph);
+    void breadth_first_search(const ComponentGraph &graph1,
+                              const ComponentGraph &graph2,
+                              std::vector<int> &queue,
+                              std::vector<int> &distances) const;
+public:
+    template<class TransitionSystem>
+    VirtualProduct(const TransitionSystem &ts1, const TransitionSystem &ts2);
+
+    int get_size() const {
+        return size1 * size2;
+    }
+
+    int get_init_state() const {
+        return init_state;
+    }
+
+    int get_num_label_groups() const {
+        return num_label_groups;
+    }
+
+    /*
+      Call callback(group, target) for every product transition from the
+      given state. The transitions are not ordered, but every transition
+      is enumerated exactly once.
+    */
+    template<class Callback>
+    void for_each_successor(int state, const Callback &callback) const {
+        for_each_neighbor(forward1, forward2, state, callback);
+    }
+
+    // Call callback(group, src) for every product transition into state.
+    template<class Callback>
+    void for_each_predecessor(int state, const Callback &callback) const {
+        for_each_neighbor(backward1, backward2, state, callback);
+    }
+
+    /*
+      Distances from the initial state and to the goal states in number
+      of transitions, ignoring label costs. As with Distances, states
+      that cannot be reached have distance INF.
+    */
+    std::vector<int> compute_init_distances() const;
+    std::vector<int> compute_goal_distances() const;
+};
+
+template<class TransitionSystem>
+VirtualProduct::VirtualProduct(
+    const TransitionSystem &ts1, const TransitionSystem &ts2)
+    : size1(ts1.get_size()),
+      size2(ts2.get_size()),
+      init_state(ts1.get_init_state() * size2 + ts2.get_init_state()),
+      num_label_groups(0) {
+    assert(ts1.get_init_state() != PRUNED_STATE &&
+           ts2.get_init_state() != PRUNED_STATE);
+    for (int s1 = 0; s1 < size1; ++s1) {
+        if (ts1.is_goal_state(s1)) {
+            for (int s2 = 0; s2 < size2; ++s2) {
+                if (ts2.is_goal_state(s2))
+                    goal_states.push_back(s1 * size2 + s2);
+            }
+        }
+    }
+
+    /*
+      Groups of both components are numbered in the order of iteration.
+      Labels without transitions in one of the components are dead in
+      the product and belong to no product group.
+    */
+    std::vector<int> label_to_group2;
+    int group2 = 0;
+    for (const auto &gat : ts2) {
+        if (!gat.transitions.empty()) {
+            for (int label_no : gat.label_group) {
+                if (label_no >= static_cast<int>(label_to_group2.size()))
+                    label_to_group2.resize(label_no + 1, -1);
+                label_to_group2[label_no] = group2;
+            }
+        }
+        ++group2;
+    }
+    for (const auto &gat : ts1) {
+        product_groups_by_group1.emplace_back();
+        if (gat.transitions.empty())
+            continue;
+        std::vector<std::pair<int, int>> &product_groups = product_groups_by_group1.back();
+        for (int label_no : gat.label_group) {
+            if (label_no < static_cast<int>(label_to_group2.size()) &&
+                label_to_group2[label_no] != -1) {
+                product_groups.emplace_back(label_to_group2[label_no], -1);
+            }
+        }
+        std::sort(product_groups.begin(), product_groups.end());
+        product_groups.erase(std::unique(product_groups.begin(), product_groups.end()),
+                             product_groups.end());
+        for (std::pair<int, int> &product_group : product_groups) {
+            product_group.second = num_label_groups++;
+        }
+    }
+
+    build_graph(ts1, false, forward1);
+    build_graph(ts1, true, backward1);
+    build_graph(ts2, false, forward2);
+    build_graph(ts2, true, backward2);
+}
+
+template<class TransitionSystem>
+void VirtualProduct::build_graph(
+    const TransitionSystem &ts, bool backward, ComponentGraph &graph) {
+    int num_states = ts.get_size();
+    std::vector<int> &state_first_arc = graph.state_first_arc;
+    state_first_arc.assign(num_states + 1, 0);
+    for (const auto &gat : ts) {
+        for (const auto &transition : gat.transitions) {
+            int from = backward ? transition.target : transition.src;
+            ++state_first_arc[from + 1];
+        }
+    }
+    for (int state = 0; state < num_states; ++state) {
+        state_first_arc[state + 1] += state_first_arc[state];
+    }
+
+    // Groups are visited in order, so the arcs of each state are ordered by group.
+    graph.arcs.resize(state_first_arc[num_states]);
+    std::vector<int> next_arc(state_first_arc.begin(), state_first_arc.end() - 1);
+    int group = 0;
+    for (const auto &gat : ts) {
+        for (const auto &transition : gat.transitions) {
+            int from = backward ? transition.target : transition.src;
+            int to = backward ? transition.src : transition.target;
+            graph.arcs[next_arc[from]++] = std::make_pair(group, to);
+        }
+        ++group;
+    }
+}
+}
+
+#endif
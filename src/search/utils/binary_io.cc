@@ -0,0 +1,122 @@
+#include "binary_io.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace utils {
+void BinaryWriter::write_int(int value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    char bytes[4] = {
+        static_cast<char>(bits & 0xff),
+        static_cast<char>((bits >> 8) & 0xff),
+        static_cast<char>((bits >> 16) & 0xff),
+        static_cast<char>((bits >> 24) & 0xff)
+    };
+    data.append(bytes, 4);
+}
+
+void BinaryWriter::write_ints(const vector<int> &values) {
+    data.reserve(data.size() + 4 * (values.size() + 1));
+    write_int(values.size());
+    for (int value : values) {
+        write_int(value);
+    }
+}
+
+void BinaryWriter::write_bools(const vector<bool> &values) {
+    // One byte per entry, padded to a multiple of four bytes
+    write_int(values.size());
+    size_t padded_size = (values.size() + 3) / 4 * 4;
+    for (size_t i = 0; i < padded_size; ++i) {
+        data.push_back(i < values.size() && values[i]);
+    }
+}
+
+void BinaryWriter::write_string(const string &value) {
+    write_int(value.size());
+    data.append(value);
+}
+
+
+BinaryReader::BinaryReader(string &&data)
+    : owned_data(move(data)),
+      data(owned_data.data()),
+      size(owned_data.size()),
+      pos(0) {
+}
+
+BinaryReader::BinaryReader(const char *data, size_t size)
+    : data(data), size(size), pos(0) {
+}
+
+void BinaryReader::check_available(size_t num_bytes) const {
+    if (size - pos < num_bytes) {
+        throw BinaryReadError(
+            "unexpected end of data after " + to_string(pos) + " bytes");
+    }
+}
+
+int BinaryReader::read_int() {
+    check_available(4);
+    const unsigned char *bytes =
+        reinterpret_cast<const unsigned char *>(data + pos);
+    uint32_t bits = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                    (static_cast<uint32_t>(bytes[3]) << 24);
+    pos += 4;
+    int value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int BinaryReader::read_count(size_t min_element_size) {
+    int count = read_int();
+    if (count < 0) {
+        throw BinaryReadError("negative length " + to_string(count));
+    }
+    if (static_cast<size_t>(count) > (size - pos) / min_element_size) {
+        throw BinaryReadError(
+            "length " + to_string(count) + " after " + to_string(pos) +
+            " bytes exceeds the size of the data");
+    }
+    return count;
+}
+
+vector<int> BinaryReader::read_ints() {
+    size_t count = read_count(4);
+    vector<int> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(read_int());
+    }
+    return values;
+}
+
+vector<bool> BinaryReader::read_bools() {
+    size_t count = read_count();
+    size_t padded_size = (count + 3) / 4 * 4;
+    check_available(padded_size);
+    vector<bool> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = data[pos + i] != 0;
+    }
+    pos += padded_size;
+    return values;
+}
+
+string BinaryReader::read_string() {
+    size_t length = read_count();
+    string result(data + pos, length);
+    pos += length;
+    return result;
+}
+
+const char *BinaryReader::read_bytes(size_t num_bytes) {
+    check_available(num_bytes);
+    const char *bytes = data + pos;
+    pos += num_bytes;
+    return bytes;
+}
+}
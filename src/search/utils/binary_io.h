@@ -0,0 +1,85 @@
+#ifndef UTILS_BINARY_IO_H
+#define UTILS_BINARY_IO_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+struct BinaryReadError {
+    std::string msg;
+
+    explicit BinaryReadError(const std::string &msg)
+        : msg(msg) {
+    }
+};
+
+/*
+  Serializes data into an in-memory buffer. Integers are stored as 32-bit
+  little-endian values, vectors and strings are prefixed with their length.
+*/
+class BinaryWriter {
+    std::string data;
+public:
+    void write_int(int value);
+    void write_bool(bool value) {
+        write_int(value);
+    }
+    void write_ints(const std::vector<int> &values);
+    void write_bools(const std::vector<bool> &values);
+    void write_string(const std::string &value);
+
+    const std::string &get_data() const {
+        return data;
+    }
+};
+
+/*
+  Reads data written by BinaryWriter. Reading past the end of the data or
+  reading a negative length throws a BinaryReadError.
+
+  The reader either owns its data or, with the second constructor, reads
+  from memory owned by the caller, e.g. a memory-mapped file. The memory
+  must then outlive the reader.
+*/
+class BinaryReader {
+    std::string owned_data;
+    const char *data;
+    std::size_t size;
+    std::size_t pos;
+
+    void check_available(std::size_t num_bytes) const;
+public:
+    explicit BinaryReader(std::string &&data);
+    BinaryReader(const char *data, std::size_t size);
+    BinaryReader(const BinaryReader &) = delete;
+    BinaryReader &operator=(const BinaryReader &) = delete;
+
+    int read_int();
+    bool read_bool() {
+        return read_int() != 0;
+    }
+    /*
+      Reads the length of an array and checks that it is non-negative and
+      that the remaining data can hold that many elements of at least
+      min_element_size bytes each. Callers can thus allocate memory for the
+      elements before reading them.
+    */
+    int read_count(std::size_t min_element_size = 1);
+    std::vector<int> read_ints();
+    std::vector<bool> read_bools();
+    std::string read_string();
+    // Returns the next num_bytes bytes, which stay valid as long as the data
+    const char *read_bytes(std::size_t num_bytes);
+
+    std::size_t get_position() const {
+        return pos;
+    }
+
+    bool at_end() const {
+        return pos == size;
+    }
+};
+}
+
+#endif
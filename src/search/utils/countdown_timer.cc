@@ -33,4 +33,22 @@ ostream &operator<<(ostream &os, const CountdownTimer &cd_timer) {
     os << cd_timer.timer;
     return os;
 }
+
+WallClockCountdownTimer::WallClockCountdownTimer(double max_time)
+    : start(chrono::steady_clock::now()),
+      max_time(max_time) {
+}
+
+bool WallClockCountdownTimer::is_expired() const {
+    return max_time != numeric_limits<double>::infinity() &&
+           get_elapsed_time() >= max_time;
+}
+
+double WallClockCountdownTimer::get_elapsed_time() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+double WallClockCountdownTimer::get_remaining_time() const {
+    return max_time - get_elapsed_time();
+}
 }
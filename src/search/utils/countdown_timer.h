@@ -3,6 +3,7 @@
 
 #include "timer.h"
 
+#include <chrono>
 #include <ostream>
 
 namespace utils {
@@ -19,6 +20,21 @@ public:
 };
 
 std::ostream &operator<<(std::ostream &os, const CountdownTimer &cd_timer);
+
+/*
+  Like CountdownTimer, but measures wall-clock time instead of the CPU time
+  of the process, which grows faster than wall-clock time if several
+  threads are running. Use this for limits on multi-threaded computations.
+*/
+class WallClockCountdownTimer {
+    std::chrono::steady_clock::time_point start;
+    double max_time;
+public:
+    explicit WallClockCountdownTimer(double max_time);
+    bool is_expired() const;
+    double get_elapsed_time() const;
+    double get_remaining_time() const;
+};
 }
 
 #endif
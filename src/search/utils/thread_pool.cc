@@ -0,0 +1,82 @@
+#include "thread_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : task(nullptr),
+      num_tasks(0),
+      num_busy_workers(0),
+      generation(0),
+      shutting_down(false),
+      next_task(0) {
+    assert(num_threads >= 1);
+    for (int i = 1; i < num_threads; ++i) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run_tasks() {
+    int task_id;
+    while ((task_id = next_task.fetch_add(1)) < num_tasks) {
+        (*task)(task_id);
+    }
+}
+
+void ThreadPool::work() {
+    int seen_generation = 0;
+    while (true) {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            work_available.wait(lock, [&]() {
+                                    return shutting_down || generation != seen_generation;
+                                });
+            if (shutting_down)
+                return;
+            seen_generation = generation;
+        }
+        run_tasks();
+        {
+            lock_guard<std::mutex> lock(mutex);
+            --num_busy_workers;
+        }
+        work_finished.notify_one();
+    }
+}
+
+void ThreadPool::run(int num_tasks_, const function<void(int)> &task_) {
+    if (workers.empty() || num_tasks_ <= 1) {
+        for (int i = 0; i < num_tasks_; ++i) {
+            task_(i);
+        }
+        return;
+    }
+    {
+        lock_guard<std::mutex> lock(mutex);
+        assert(num_busy_workers == 0);
+        task = &task_;
+        num_tasks = num_tasks_;
+        next_task = 0;
+        num_busy_workers = workers.size();
+        ++generation;
+    }
+    work_available.notify_all();
+    run_tasks();
+    unique_lock<std::mutex> lock(mutex);
+    work_finished.wait(lock, [&]() {return num_busy_workers == 0; });
+    task = nullptr;
+}
+}
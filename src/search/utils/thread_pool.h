@@ -0,0 +1,54 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed set of threads for running independent tasks concurrently.
+
+  run(num_tasks, task) calls task(i) for every i in [0, num_tasks) and
+  returns when all calls have finished. The calling thread takes part in
+  the work, so a pool for n threads starts n - 1 additional threads and a
+  pool with a single thread runs everything in the calling thread. Tasks
+  must not call run() themselves and must only write to data that no
+  other task accesses.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+    // The following members are protected by mutex.
+    const std::function<void(int)> *task;
+    int num_tasks;
+    int num_busy_workers;
+    int generation;
+    bool shutting_down;
+
+    std::atomic<int> next_task;
+
+    void run_tasks();
+    void work();
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const {
+        return workers.size() + 1;
+    }
+
+    void run(int num_tasks, const std::function<void(int)> &task);
+};
+}
+
+#endif